@@ -0,0 +1,267 @@
+#define _POSIX_C_SOURCE 200809L
+#include "analysis.h"
+#include "hash_map.h"
+#include "tab_system.h"   /* ENDPOINT_* */
+#include <stdlib.h>
+#include <string.h>
+
+/* --- Tag helpers --- */
+
+#define HAS_BIT(node, b) (((node)->tag_bits & TAG_BIT(b)) != 0)
+
+const char *entity_pipeline_phase(const entity_node_t *node) {
+    uint64_t builtin = node->tag_bits & TAG_MASK_BUILTIN_PHASES;
+    if (builtin) {
+        int bit = TAG_BIT_PHASE_FIRST;
+        while (!(builtin & TAG_BIT(bit))) bit++;
+        return intern_str(INTERN_TAG_PHASE_ONSTART + (intern_id_t)(bit - TAG_BIT_PHASE_FIRST)) + 15;
+    }
+    if (!HAS_BIT(node, TAG_BIT_CUSTOM_PHASE)) return NULL;
+
+    for (int i = 0; i < node->tag_count; i++) {
+        const char *tag = intern_str(node->tag_ids[i]);
+        if (tag && strncmp(tag, "flecs.pipeline.", 15) == 0) {
+            const char *phase = tag + 15;
+            if (phase[0] != '\0') return phase;
+        }
+    }
+    return NULL;
+}
+
+/* --- Entity classification (CELS-C sections) --- */
+
+/* Check if entity is a user-defined lifecycle controller.
+ * Matches CEL_Lifecycle macro names: "MainMenuLC", "SettingsCycle", etc.
+ * Does NOT match CELS_LifecycleSystem (that's a system, not a lifecycle). */
+static bool name_is_lifecycle(const entity_node_t *node) {
+    if (!node->name) return false;
+    /* Suffix: CEL_Lifecycle macro names (MainMenuLC, SettingsLC, MenuCycle) */
+    size_t nlen = strlen(node->name);
+    if (nlen >= 2 && strcmp(node->name + nlen - 2, "LC") == 0) return true;
+    if (nlen >= 5 && strcmp(node->name + nlen - 5, "Cycle") == 0) return true;
+    /* Legacy: "lifecycle_0x..." prefix from old naming */
+    if (strncmp(node->name, "lifecycle_", 10) == 0) return true;
+    return false;
+}
+
+/* Check if name ends with "State" (case-sensitive) */
+static bool name_ends_with_state(const entity_node_t *node) {
+    if (!node->name) return false;
+    const char *suffix = "State";
+    size_t nlen = strlen(node->name);
+    size_t slen = strlen(suffix);
+    if (nlen < slen) return false;
+    return strcmp(node->name + nlen - slen, suffix) == 0;
+}
+
+/* Classify a single node (root-level only -- children inherit) */
+static entity_class_t classify_node(entity_node_t *node) {
+    node->class_detail = NULL;
+
+    /* Systems -- flecs.system.System tag, observers */
+    if (HAS_BIT(node, TAG_BIT_SYSTEM)) {
+        node->class_detail = entity_pipeline_phase(node);
+        if (!node->class_detail) node->class_detail = "System";
+        return ENTITY_CLASS_SYSTEM;
+    }
+    if (HAS_BIT(node, TAG_BIT_OBSERVER)) {
+        node->class_detail = "Observer";
+        return ENTITY_CLASS_SYSTEM;
+    }
+    /* L: Lifecycles -- user-defined lifecycle entities (after system check so
+       CELS_LifecycleSystem stays classified as a system) */
+    if (name_is_lifecycle(node)) {
+        return ENTITY_CLASS_LIFECYCLE;
+    }
+    /* Components -- component type entities */
+    if (HAS_BIT(node, TAG_BIT_COMPONENT)) {
+        return ENTITY_CLASS_COMPONENT;
+    }
+    /* S: State -- entities whose name ends with "State" */
+    if (name_ends_with_state(node)) {
+        return ENTITY_CLASS_STATE;
+    }
+    /* E: Entities -- leaf scene entities (no children, have component data) */
+    if (node->child_count == 0 && node->component_count > 0) {
+        return ENTITY_CLASS_ENTITY;
+    }
+    /* C: Compositions -- parent entities (have children = scene structure) */
+    return ENTITY_CLASS_COMPOSITION;
+}
+
+/* Propagate a class to all descendants */
+static void propagate_class(entity_node_t *node, entity_class_t cls) {
+    node->entity_class = cls;
+    for (int i = 0; i < node->child_count; i++) {
+        propagate_class(node->children[i], cls);
+    }
+}
+
+/* Classify all roots in entity list -- children inherit root's class */
+static void classify_all_entities(entity_list_t *list) {
+    for (int i = 0; i < list->root_count; i++) {
+        entity_class_t cls = classify_node(list->roots[i]);
+        propagate_class(list->roots[i], cls);
+    }
+}
+
+/* Classify only what changed since the previous generation. Unchanged
+ * nodes already carry their class over from entity_list_reconcile(). */
+static void classify_changed_entities(entity_list_t *list) {
+    const entity_change_set_t *cs = &list->changes;
+
+    /* Roots first: a changed root re-derives the class of its subtree */
+    for (int i = 0; i < list->root_count; i++) {
+        entity_node_t *root = list->roots[i];
+        if (root->changed) propagate_class(root, classify_node(root));
+    }
+
+    /* Changed nodes below unchanged roots inherit the root's class */
+    const uint64_t *ids[2] = { cs->added, cs->modified };
+    int counts[2] = { cs->added_count, cs->modified_count };
+    for (int k = 0; k < 2; k++) {
+        for (int i = 0; i < counts[k]; i++) {
+            entity_node_t *node = entity_list_find_by_id(list, ids[k][i]);
+            if (!node || !node->parent) continue;
+            entity_node_t *root = node->parent;
+            while (root->parent) root = root->parent;
+            node->entity_class = root->entity_class;
+        }
+    }
+}
+
+/* --- Annotation: enrich component entities with registry data --- */
+
+/* Registry entries by name (first occurrence wins) */
+static bool registry_by_name(str_map_t *by_name, const component_registry_t *reg) {
+    if (!str_map_init(by_name, (size_t)reg->count)) return false;
+    for (int r = 0; r < reg->count; r++) {
+        const char *name = reg->components[r].name;
+        if (name && !str_map_get(by_name, name, strlen(name))) {
+            str_map_put(by_name, name, strlen(name), &reg->components[r]);
+        }
+    }
+    return true;
+}
+
+static void annotate_component_entities(entity_list_t *list,
+                                        const component_registry_t *reg,
+                                        bool changed_only) {
+    str_map_t by_name = {0};
+    if (!registry_by_name(&by_name, reg)) return;
+
+    for (int i = 0; i < list->root_count; i++) {
+        entity_node_t *node = list->roots[i];
+        if (changed_only && !node->changed) continue;
+        if (node->entity_class != ENTITY_CLASS_COMPONENT || !node->name) continue;
+
+        /* tree_view formats the numbers */
+        const component_info_t *ci = str_map_get(&by_name, node->name, strlen(node->name));
+        node->has_component_info = ci != NULL;
+        if (ci) {
+            node->component_entity_count = ci->entity_count;
+            node->component_size = ci->has_type_info ? ci->size : 0;
+        }
+    }
+    str_map_fini(&by_name);
+}
+
+/* Row size estimate of every archetype: the registry size of each of its
+ * components, kept per component for the signature view. Tags take no
+ * space; components the registry has no type info for are counted
+ * separately so the estimate can be flagged. */
+static void size_archetypes(entity_list_t *list, const component_registry_t *reg) {
+    str_map_t by_name = {0};
+    if (reg && !registry_by_name(&by_name, reg)) return;
+
+    for (int a = 0; a < list->archetype_count; a++) {
+        archetype_t *arch = &list->archetypes[a];
+        arch->row_size = 0;
+        arch->unsized_count = 0;
+        for (int c = 0; c < arch->component_count; c++) {
+            const char *name = intern_str(arch->ids[c]);
+            const component_info_t *ci = name && reg
+                ? str_map_get(&by_name, name, strlen(name)) : NULL;
+            arch->component_sizes[c] = ci && ci->has_type_info ? ci->size : -1;
+            if (ci && ci->has_type_info) {
+                arch->row_size += ci->size;
+            } else {
+                arch->unsized_count++;
+            }
+        }
+    }
+    str_map_fini(&by_name);
+}
+
+/* --- Enrichment: pipeline stats <-> system entities --- */
+
+/* Match count and disabled flag onto system entities */
+static void enrich_system_entities(entity_list_t *list, const system_index_t *index) {
+    if (index->count == 0) return;
+    for (int i = 0; i < list->root_count; i++) {
+        entity_node_t *node = list->roots[i];
+        if (node->entity_class != ENTITY_CLASS_SYSTEM) continue;
+
+        const system_info_t *si = system_index_for_entity(index, node);
+        if (si) {
+            node->system_match_count = si->matched_entity_count;
+            node->disabled = si->disabled;
+        }
+    }
+}
+
+/* Phase of every system, from its entity's pipeline tag (NULL = unknown) */
+static void assign_system_phases(system_registry_t *reg, const system_index_t *index) {
+    for (int s = 0; s < reg->count; s++) {
+        system_info_t *si = &reg->systems[s];
+        free(si->phase);
+        si->phase = NULL;
+
+        const entity_node_t *node = system_index_entity(index, s);
+        if (!node || !HAS_BIT(node, TAG_BIT_SYSTEM)) continue;
+        const char *phase = entity_pipeline_phase(node);
+        if (phase) si->phase = strdup(phase);
+    }
+}
+
+/* --- Public API --- */
+
+void analysis_update(entity_list_t *list, const component_registry_t *components,
+                     system_registry_t *systems, const system_index_t *index,
+                     uint32_t changed) {
+    bool list_changed = (changed & ENDPOINT_QUERY) != 0;
+    bool components_changed = (changed & ENDPOINT_COMPONENTS) != 0;
+    bool systems_changed = (changed & ENDPOINT_STATS_PIPELINE) != 0;
+
+    if (list) {
+        /* The change set describes the step from the previously installed
+         * list, which was analyzed when it was installed */
+        bool incremental = list_changed && !list->changes.full;
+
+        if (incremental) {
+            classify_changed_entities(list);
+        } else if (list_changed) {
+            classify_all_entities(list);
+        }
+
+        if (components) {
+            if (components_changed || (list_changed && !incremental)) {
+                annotate_component_entities(list, components, false);
+            } else if (incremental) {
+                annotate_component_entities(list, components, true);
+            }
+        }
+
+        if (list_changed || components_changed) {
+            size_archetypes(list, components);
+        }
+
+        if (index && (list_changed || systems_changed)) {
+            enrich_system_entities(list, index);
+        }
+    }
+
+    if (systems && index && (list_changed || systems_changed)) {
+        assign_system_phases(systems, index);
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef CELS_DEBUG_ANALYSIS_H
+#define CELS_DEBUG_ANALYSIS_H
+
+#include "data_model.h"
+#include "system_index.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Derived state shared by every tab, computed once per data generation.
+ *
+ * After the main loop installs a poll result it runs analysis_update()
+ * with the ENDPOINT_* mask of the datasets that were replaced. The results
+ * are cached on the data model itself:
+ *   entity nodes    entity_class / class_detail (CELS-C section, phase),
+ *                   component registry annotation, pipeline enrichment
+ *   archetype_t     component_sizes / row_size / unsized_count, from the
+ *                   registry sizes
+ *   system_info_t   phase, from the system's entity tags
+ * Tabs only read these fields; nothing is classified during draw. An
+ * entity list that entity_list_reconcile() diffed against its predecessor
+ * is only re-derived where nodes changed. Tag checks are bit tests on
+ * entity_node_t.tag_bits, filled by the parser. */
+
+/* Pipeline phase from a "flecs.pipeline.<Phase>" tag ("OnUpdate"), or
+ * NULL. Points into the interned tag string. Builtin phases are read from
+ * tag_bits; only custom phases look at the tag strings. */
+const char *entity_pipeline_phase(const entity_node_t *node);
+
+/* Bring the derived state up to date after the datasets in changed
+ * (ENDPOINT_* bits) were replaced. Any pointer may be NULL. */
+void analysis_update(entity_list_t *list, const component_registry_t *components,
+                     system_registry_t *systems, const system_index_t *index,
+                     uint32_t changed);
+
+#endif /* CELS_DEBUG_ANALYSIS_H */
@@ -0,0 +1,93 @@
+#include "arena.h"
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_MIN_CHUNK  (16u * 1024u)
+#define ARENA_MAX_CHUNK  (64u * 1024u * 1024u)  /* growth cap, not a size limit */
+#define ARENA_ALIGN      alignof(max_align_t)
+
+struct arena_chunk {
+    arena_chunk_t *next;
+    size_t         capacity;
+    size_t         used;
+    alignas(max_align_t) unsigned char data[];
+};
+
+void arena_init(arena_t *a, size_t first_chunk_size) {
+    a->head = NULL;
+    a->next_size = first_chunk_size < ARENA_MIN_CHUNK ? ARENA_MIN_CHUNK
+                                                      : first_chunk_size;
+    a->used_bytes = 0;
+}
+
+void arena_free(arena_t *a) {
+    arena_chunk_t *c = a->head;
+    while (c) {
+        arena_chunk_t *next = c->next;
+        free(c);
+        c = next;
+    }
+    a->head = NULL;
+    a->used_bytes = 0;
+}
+
+static arena_chunk_t *arena_grow(arena_t *a, size_t min_size) {
+    size_t cap = a->next_size ? a->next_size : ARENA_MIN_CHUNK;
+    if (cap < min_size) cap = min_size;
+
+    arena_chunk_t *c = malloc(sizeof(arena_chunk_t) + cap);
+    if (!c) return NULL;
+    c->next = a->head;
+    c->capacity = cap;
+    c->used = 0;
+    a->head = c;
+
+    /* Double each time so the chunk count stays logarithmic */
+    if (cap < ARENA_MAX_CHUNK) a->next_size = cap * 2;
+    return c;
+}
+
+/* Bump-allocate size bytes at the given power-of-two alignment */
+static void *arena_push(arena_t *a, size_t size, size_t align) {
+    if (size > SIZE_MAX - ARENA_ALIGN) return NULL;
+
+    arena_chunk_t *c = a->head;
+    size_t offset = 0;
+    if (c) offset = (c->used + align - 1) & ~(align - 1);
+    if (!c || offset > c->capacity || c->capacity - offset < size) {
+        c = arena_grow(a, size);
+        if (!c) return NULL;
+        offset = 0;
+    }
+
+    c->used = offset + size;
+    a->used_bytes += size;
+    return c->data + offset;
+}
+
+void *arena_alloc(arena_t *a, size_t size) {
+    return arena_push(a, size ? size : 1, ARENA_ALIGN);
+}
+
+void *arena_calloc(arena_t *a, size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) return NULL;
+    void *p = arena_alloc(a, count * size);
+    if (p) memset(p, 0, count * size);
+    return p;
+}
+
+char *arena_strndup(arena_t *a, const char *s, size_t len) {
+    /* Strings pack back to back -- no alignment padding */
+    char *p = arena_push(a, len + 1, 1);
+    if (!p) return NULL;
+    memcpy(p, s, len);
+    p[len] = '\0';
+    return p;
+}
+
+char *arena_strdup(arena_t *a, const char *s) {
+    if (!s) return NULL;
+    return arena_strndup(a, s, strlen(s));
+}
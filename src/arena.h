@@ -0,0 +1,38 @@
+#ifndef CELS_DEBUG_ARENA_H
+#define CELS_DEBUG_ARENA_H
+
+#include <stddef.h>
+
+/* Bump allocator with chunked, geometric growth.
+ *
+ * Everything allocated from an arena is released at once by arena_free(),
+ * which walks only the chunk list (logarithmic in the bytes allocated), so
+ * a whole data generation can be dropped without touching its objects.
+ * Individual allocations cannot be freed or resized. A zeroed arena_t is
+ * valid and allocates its first chunk lazily. */
+
+typedef struct arena_chunk arena_chunk_t;
+
+typedef struct arena {
+    arena_chunk_t *head;       /* current chunk (older chunks linked behind) */
+    size_t         next_size;  /* capacity of the next chunk to allocate */
+    size_t         used_bytes; /* sum of all allocation sizes (stats) */
+} arena_t;
+
+/* Set the first chunk's capacity (e.g. from the input size). Optional. */
+void arena_init(arena_t *a, size_t first_chunk_size);
+
+/* Release every chunk. The arena can be reused afterwards. */
+void arena_free(arena_t *a);
+
+/* Aligned for any type. Returns NULL on allocation failure. */
+void *arena_alloc(arena_t *a, size_t size);
+
+/* Zeroed array of count * size bytes (overflow checked). */
+void *arena_calloc(arena_t *a, size_t count, size_t size);
+
+/* Copy a NUL-terminated string / the first len bytes plus a terminator. */
+char *arena_strdup(arena_t *a, const char *s);
+char *arena_strndup(arena_t *a, const char *s, size_t len);
+
+#endif /* CELS_DEBUG_ARENA_H */
@@ -1,6 +1,7 @@
-#define _POSIX_C_SOURCE 199309L
+#define _POSIX_C_SOURCE 200809L
 #include "data_model.h"
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 world_snapshot_t *world_snapshot_create(void) {
@@ -14,67 +15,473 @@ world_snapshot_t *world_snapshot_create(void) {
 }
 
 void world_snapshot_free(world_snapshot_t *snap) {
+    if (!snap) return;
+    metric_window_set_fini(&snap->windows);
+    free(snap->raw_json);
     free(snap);
 }
 
-/* --- Entity node --- */
+void metric_window_set_fini(metric_window_set_t *set) {
+    free(set->metrics);
+    free(set->values);
+    memset(set, 0, sizeof(*set));
+}
+
+// Copy src into dst, re-pointing every window into dst's own value block
+static bool metric_window_set_copy(metric_window_set_t *dst, const metric_window_set_t *src) {
+    memset(dst, 0, sizeof(*dst));
+    if (src->count == 0) return true;
+
+    size_t values = (size_t)src->count * 3 * (size_t)src->window_len;
+    dst->metrics = malloc((size_t)src->count * sizeof(metric_window_t));
+    dst->values = malloc(values * sizeof(double));
+    if (!dst->metrics || !dst->values) {
+        metric_window_set_fini(dst);
+        return false;
+    }
+    memcpy(dst->values, src->values, values * sizeof(double));
+    for (int i = 0; i < src->count; i++) {
+        const metric_window_t *m = &src->metrics[i];
+        dst->metrics[i] = (metric_window_t){
+            .name = m->name,
+            .avg = dst->values + (m->avg - src->values),
+            .min = dst->values + (m->min - src->values),
+            .max = dst->values + (m->max - src->values),
+        };
+    }
+    dst->count = src->count;
+    dst->window_len = src->window_len;
+    return true;
+}
 
-entity_node_t *entity_node_create(void) {
-    entity_node_t *node = calloc(1, sizeof(entity_node_t));
+world_snapshot_t *world_snapshot_clone(const world_snapshot_t *snap) {
+    if (!snap) return NULL;
+    world_snapshot_t *copy = malloc(sizeof(world_snapshot_t));
+    if (!copy) return NULL;
+    *copy = *snap;
+    copy->raw_json = NULL;
+    if (!metric_window_set_copy(&copy->windows, &snap->windows) ||
+        (snap->raw_json && !(copy->raw_json = strdup(snap->raw_json)))) {
+        world_snapshot_free(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+/* --- Entity list --- */
+
+entity_list_t *entity_list_create(size_t arena_hint) {
+    entity_list_t *list = calloc(1, sizeof(entity_list_t));
+    if (list) arena_init(&list->arena, arena_hint);
+    return list;
+}
+
+entity_node_t *entity_list_new_node(entity_list_t *list) {
+    entity_node_t *node = arena_calloc(&list->arena, 1, sizeof(entity_node_t));
     if (node) {
         node->expanded = true;
     }
     return node;
 }
 
-void entity_node_free(entity_node_t *node) {
-    if (!node) return;
-    free(node->name);
-    free(node->full_path);
+void entity_list_free(entity_list_t *list) {
+    if (!list) return;
+    arena_free(&list->arena);  /* nodes, strings, nodes[], roots[] */
+    str_map_fini(&list->by_path);
+    u64_map_fini(&list->by_id);
+    u64_map_fini(&list->tag_bit_of);
+    u64_map_fini(&list->by_component.slot_of);
+    free(list);
+}
+
+/* Bit for a tag seen for the first time in this list, or -1 */
+static int assign_tag_bit(intern_id_t tag) {
+    switch (tag) {
+    case INTERN_TAG_SYSTEM:   return TAG_BIT_SYSTEM;
+    case INTERN_TAG_OBSERVER: return TAG_BIT_OBSERVER;
+    default: break;
+    }
+    if (tag >= INTERN_TAG_PHASE_ONSTART && tag <= INTERN_TAG_PHASE_POSTFRAME) {
+        return TAG_BIT_PHASE_FIRST + (int)(tag - INTERN_TAG_PHASE_ONSTART);
+    }
+    const char *name = intern_str(tag);
+    if (name && strncmp(name, "flecs.pipeline.", 15) == 0 && name[15] != '\0') {
+        return TAG_BIT_CUSTOM_PHASE;
+    }
+    return -1;
+}
+
+void entity_list_index_tags(entity_list_t *list, entity_node_t *node) {
+    uint64_t bits = 0;
     for (int i = 0; i < node->component_count; i++) {
-        free(node->component_names[i]);
+        if (node->component_ids[i] == INTERN_COMPONENT) {
+            bits |= TAG_BIT(TAG_BIT_COMPONENT);
+            break;
+        }
     }
-    free(node->component_names);
     for (int i = 0; i < node->tag_count; i++) {
-        free(node->tags[i]);
+        intern_id_t tag = node->tag_ids[i];
+        uintptr_t slot = (uintptr_t)u64_map_get(&list->tag_bit_of, tag);
+        if (slot == 0) {
+            /* First sighting; tags left without a bit are cached as
+             * TAG_BIT_COUNT + 1 */
+            int bit = assign_tag_bit(tag);
+            slot = bit < 0 ? TAG_BIT_COUNT + 1 : (uintptr_t)bit + 1;
+            u64_map_put(&list->tag_bit_of, tag, (void *)slot);
+        }
+        if (slot <= TAG_BIT_COUNT) bits |= TAG_BIT(slot - 1);
     }
-    free(node->tags);
-    free(node->children);  /* NOT recursive -- entity_list_free handles nodes */
-    free(node->class_detail);
-    free(node);
+    node->tag_bits = bits;
 }
 
-void entity_node_add_child(entity_node_t *parent, entity_node_t *child) {
-    if (!parent || !child) return;
+/* --- Component index --- */
 
-    if (parent->child_count >= parent->child_capacity) {
-        int new_cap = parent->child_capacity == 0 ? 4 : parent->child_capacity * 2;
-        entity_node_t **new_children =
-            realloc(parent->children, (size_t)new_cap * sizeof(entity_node_t *));
-        if (!new_children) return;
-        parent->children = new_children;
-        parent->child_capacity = new_cap;
+static int cmp_node_id(const void *a, const void *b) {
+    uint64_t ia = (*(entity_node_t *const *)a)->id;
+    uint64_t ib = (*(entity_node_t *const *)b)->id;
+    return (ia > ib) - (ia < ib);
+}
+
+bool entity_list_build_component_index(entity_list_t *list) {
+    component_index_t *ci = &list->by_component;
+    u64_map_fini(&ci->slot_of);
+    memset(ci, 0, sizeof(*ci));
+
+    /* Pass 1: slot per distinct component, pair counts in offsets[k + 1] */
+    size_t pairs = 0;
+    for (int i = 0; i < list->count; i++) pairs += (size_t)list->nodes[i]->component_count;
+    if (pairs == 0) return true;
+
+    uint32_t *counts = calloc(pairs + 1, sizeof(uint32_t));  /* slots <= pairs */
+    if (!counts) return false;
+    int slots = 0;
+    for (int i = 0; i < list->count; i++) {
+        const entity_node_t *node = list->nodes[i];
+        for (int c = 0; c < node->component_count; c++) {
+            intern_id_t id = node->component_ids[c];
+            uintptr_t slot = (uintptr_t)u64_map_get(&ci->slot_of, id);
+            if (slot == 0) {
+                slot = (uintptr_t)++slots;
+                if (!u64_map_put(&ci->slot_of, id, (void *)slot)) {
+                    free(counts);
+                    u64_map_fini(&ci->slot_of);
+                    return false;
+                }
+            }
+            counts[slot]++;
+        }
+    }
+
+    /* Pass 2: prefix sums, then scatter */
+    ci->offsets = arena_alloc(&list->arena, (size_t)(slots + 1) * sizeof(uint32_t));
+    ci->entities = arena_alloc(&list->arena, pairs * sizeof(entity_node_t *));
+    if (!ci->offsets || !ci->entities) {
+        free(counts);
+        u64_map_fini(&ci->slot_of);
+        memset(ci, 0, sizeof(*ci));
+        return false;
+    }
+    ci->offsets[0] = 0;
+    for (int k = 0; k < slots; k++) {
+        ci->offsets[k + 1] = ci->offsets[k] + counts[k + 1];
+        counts[k + 1] = ci->offsets[k];   /* reused as the fill cursor */
+    }
+    for (int i = 0; i < list->count; i++) {
+        entity_node_t *node = list->nodes[i];
+        for (int c = 0; c < node->component_count; c++) {
+            uintptr_t slot = (uintptr_t)u64_map_get(&ci->slot_of, node->component_ids[c]);
+            ci->entities[counts[slot]++] = node;
+        }
+    }
+    free(counts);
+
+    /* Parse order is mostly id order already, so the sorts are cheap */
+    for (int k = 0; k < slots; k++) {
+        qsort(ci->entities + ci->offsets[k], ci->offsets[k + 1] - ci->offsets[k],
+              sizeof(entity_node_t *), cmp_node_id);
     }
+    ci->slot_count = slots;
+    return true;
+}
 
-    parent->children[parent->child_count++] = child;
-    child->parent = parent;
-    child->depth = parent->depth + 1;
+entity_node_t *const *entity_list_with_component(const entity_list_t *list,
+                                                 intern_id_t component, int *count) {
+    *count = 0;
+    if (!list || component == INTERN_NONE || list->by_component.slot_count == 0) return NULL;
+    const component_index_t *ci = &list->by_component;
+    uintptr_t slot = (uintptr_t)u64_map_get(&ci->slot_of, component);
+    if (slot == 0) return NULL;
+    *count = (int)(ci->offsets[slot] - ci->offsets[slot - 1]);
+    return ci->entities + ci->offsets[slot - 1];
 }
 
-/* --- Entity list --- */
+/* --- Archetypes --- */
 
-entity_list_t *entity_list_create(void) {
-    return calloc(1, sizeof(entity_list_t));
+static int cmp_intern_id(const void *a, const void *b) {
+    intern_id_t ia = *(const intern_id_t *)a;
+    intern_id_t ib = *(const intern_id_t *)b;
+    return (ia > ib) - (ia < ib);
 }
 
-void entity_list_free(entity_list_t *list) {
-    if (!list) return;
+/* Sum of per-id hashes: removing one id from a set is one subtraction,
+ * which is what the neighbor search below relies on */
+static uint64_t archetype_hash(const intern_id_t *ids, int count) {
+    uint64_t h = 0;
+    for (int i = 0; i < count; i++) h += hash_u64(ids[i]);
+    return h;
+}
+
+/* Does archetype a hold exactly ids (skip = index of ids to ignore, or -1)? */
+static bool archetype_matches(const archetype_t *a, const intern_id_t *ids,
+                              int component_count, int tag_count, int skip) {
+    if (a->component_count != component_count || a->tag_count != tag_count) return false;
+    int total = component_count + tag_count;
+    for (int i = 0, j = 0; i < total; i++, j++) {
+        if (j == skip) j++;
+        if (a->ids[i] != ids[j]) return false;
+    }
+    return true;
+}
+
+/* Archetype slot for a set, probing past hash collisions; -1 if absent.
+ * *key receives the map key the set has or would get. */
+static int find_archetype(const u64_map_t *map, const archetype_t *archetypes,
+                          uint64_t hash, const intern_id_t *ids,
+                          int component_count, int tag_count, int skip,
+                          uint64_t *key) {
+    for (uint64_t k = hash;; k++) {
+        uintptr_t slot = (uintptr_t)u64_map_get(map, k);
+        if (slot == 0) {
+            if (key) *key = k;
+            return -1;
+        }
+        if (archetypes[slot - 1].hash == hash &&
+            archetype_matches(&archetypes[slot - 1], ids, component_count,
+                              tag_count, skip)) {
+            if (key) *key = k;
+            return (int)slot - 1;
+        }
+    }
+}
+
+bool entity_list_build_archetypes(entity_list_t *list) {
+    list->archetypes = NULL;
+    list->archetype_count = 0;
+    for (int i = 0; i < list->count; i++) list->nodes[i]->archetype = -1;
+    if (list->count == 0) return true;
+
+    int max_ids = 0;
     for (int i = 0; i < list->count; i++) {
-        entity_node_free(list->nodes[i]);
+        int n = list->nodes[i]->component_count + list->nodes[i]->tag_count;
+        if (n > max_ids) max_ids = n;
     }
-    free(list->nodes);
-    free(list->roots);
-    free(list);
+
+    /* Worst case is one archetype per node; the array is trimmed below */
+    u64_map_t by_hash = {0};
+    intern_id_t *scratch = malloc((size_t)(max_ids > 0 ? max_ids : 1) * sizeof(intern_id_t));
+    archetype_t *archetypes = calloc((size_t)list->count, sizeof(archetype_t));
+    bool ok = scratch && archetypes;
+
+    /* Pass 1: canonical (sorted) id set per node, deduplicated by hash */
+    int count = 0;
+    for (int i = 0; ok && i < list->count; i++) {
+        entity_node_t *node = list->nodes[i];
+        int nc = node->component_count, nt = node->tag_count;
+        if (nc > 0) memcpy(scratch, node->component_ids, (size_t)nc * sizeof(intern_id_t));
+        if (nt > 0) memcpy(scratch + nc, node->tag_ids, (size_t)nt * sizeof(intern_id_t));
+        qsort(scratch, (size_t)nc, sizeof(intern_id_t), cmp_intern_id);
+        qsort(scratch + nc, (size_t)nt, sizeof(intern_id_t), cmp_intern_id);
+
+        uint64_t hash = archetype_hash(scratch, nc + nt);
+        uint64_t key;
+        int slot = find_archetype(&by_hash, archetypes, hash, scratch, nc, nt, -1, &key);
+        if (slot < 0) {
+            archetype_t *a = &archetypes[count];
+            a->ids = arena_alloc(&list->arena,
+                                 (size_t)(nc + nt > 0 ? nc + nt : 1) * sizeof(intern_id_t));
+            a->component_sizes = arena_alloc(&list->arena,
+                                             (size_t)(nc > 0 ? nc : 1) * sizeof(int));
+            if (!a->ids || !a->component_sizes ||
+                !u64_map_put(&by_hash, key, (void *)(uintptr_t)(count + 1))) {
+                ok = false;
+                break;
+            }
+            if (nc + nt > 0) memcpy(a->ids, scratch, (size_t)(nc + nt) * sizeof(intern_id_t));
+            for (int c = 0; c < nc; c++) a->component_sizes[c] = -1;
+            a->component_count = nc;
+            a->tag_count = nt;
+            a->hash = hash;
+            slot = count++;
+        }
+        archetypes[slot].entity_count++;
+        node->archetype = slot;
+    }
+
+    /* Pass 2: one arena array for every archetype's entities */
+    entity_node_t **members = ok
+        ? arena_alloc(&list->arena, (size_t)list->count * sizeof(entity_node_t *)) : NULL;
+    archetype_t *final = ok && count > 0
+        ? arena_alloc(&list->arena, (size_t)count * sizeof(archetype_t)) : NULL;
+    if (!members || !final) ok = false;
+
+    if (ok) {
+        size_t offset = 0;
+        for (int a = 0; a < count; a++) {
+            archetypes[a].entities = members + offset;
+            offset += (size_t)archetypes[a].entity_count;
+            archetypes[a].entity_count = 0;   /* refilled below */
+        }
+        for (int i = 0; i < list->count; i++) {
+            archetype_t *a = &archetypes[list->nodes[i]->archetype];
+            a->entities[a->entity_count++] = list->nodes[i];
+        }
+
+        /* Pass 3: neighbors -- for every id of an archetype, is the set
+         * without it an archetype too? Each such edge belongs to both. The
+         * first round counts, the second fills one arena array. */
+        for (int round = 0; ok && round < 2; round++) {
+            if (round == 1) {
+                size_t edge_count = 0;
+                for (int a = 0; a < count; a++) {
+                    edge_count += (size_t)archetypes[a].neighbor_count;
+                }
+                archetype_edge_t *edges = edge_count > 0
+                    ? arena_alloc(&list->arena, edge_count * sizeof(archetype_edge_t)) : NULL;
+                if (edge_count > 0 && !edges) {
+                    ok = false;
+                    break;
+                }
+                size_t edge_offset = 0;
+                for (int a = 0; a < count; a++) {
+                    archetypes[a].neighbors = edges ? edges + edge_offset : NULL;
+                    edge_offset += (size_t)archetypes[a].neighbor_count;
+                    archetypes[a].neighbor_count = 0;   /* refilled below */
+                }
+            }
+            for (int a = 0; a < count; a++) {
+                archetype_t *arch = &archetypes[a];
+                int total = arch->component_count + arch->tag_count;
+                for (int j = 0; j < total; j++) {
+                    bool is_tag = j >= arch->component_count;
+                    int b = find_archetype(&by_hash, archetypes,
+                                           arch->hash - hash_u64(arch->ids[j]), arch->ids,
+                                           arch->component_count - !is_tag,
+                                           arch->tag_count - is_tag, j, NULL);
+                    if (b < 0) continue;
+                    if (round == 1) {
+                        /* b is arch without ids[j] */
+                        arch->neighbors[arch->neighbor_count] =
+                            (archetype_edge_t){ b, arch->ids[j], false, is_tag };
+                        archetypes[b].neighbors[archetypes[b].neighbor_count] =
+                            (archetype_edge_t){ a, arch->ids[j], true, is_tag };
+                    }
+                    arch->neighbor_count++;
+                    archetypes[b].neighbor_count++;
+                }
+            }
+        }
+    }
+
+    if (ok) {
+        memcpy(final, archetypes, (size_t)count * sizeof(archetype_t));
+        list->archetypes = final;
+        list->archetype_count = count;
+    } else {
+        for (int i = 0; i < list->count; i++) list->nodes[i]->archetype = -1;
+    }
+
+    u64_map_fini(&by_hash);
+    free(archetypes);
+    free(scratch);
+    return ok;
+}
+
+entity_node_t *entity_list_find_by_path(const entity_list_t *list, const char *path) {
+    if (!list || !path) return NULL;
+    return str_map_get(&list->by_path, path, strlen(path));
+}
+
+entity_node_t *entity_list_find_by_id(const entity_list_t *list, uint64_t id) {
+    if (!list) return NULL;
+    return u64_map_get(&list->by_id, id);
+}
+
+static inline uint64_t sig_combine(uint64_t h, uint64_t v) {
+    return hash_u64(h ^ (v + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2)));
+}
+
+uint64_t entity_node_signature(const entity_node_t *node) {
+    // The path covers name and parent; ids compare strings by identity
+    uint64_t h = node->full_path
+        ? hash_bytes(node->full_path, strlen(node->full_path)) : 0;
+    h = sig_combine(h, hash_bytes(node->component_ids,
+                                  (size_t)node->component_count * sizeof(intern_id_t)));
+    h = sig_combine(h, hash_bytes(node->tag_ids,
+                                  (size_t)node->tag_count * sizeof(intern_id_t)));
+    return sig_combine(h, (uint64_t)node->child_count);
+}
+
+bool entity_list_reconcile(entity_list_t *next, const entity_list_t *prev) {
+    entity_change_set_t *cs = &next->changes;
+    memset(cs, 0, sizeof(*cs));
+
+    cs->added = arena_alloc(&next->arena,
+                            (size_t)next->count * sizeof(uint64_t));
+    cs->modified = arena_alloc(&next->arena,
+                               (size_t)next->count * sizeof(uint64_t));
+    if (prev) {
+        cs->removed = arena_alloc(&next->arena,
+                                  (size_t)prev->count * sizeof(uint64_t));
+    }
+
+    if (!prev || !cs->added || !cs->modified || !cs->removed) {
+        // Nothing to diff against (or out of memory): everything is new
+        cs->full = true;
+        cs->added_count = 0;
+        cs->modified_count = 0;
+        for (int i = 0; i < next->count; i++) {
+            next->nodes[i]->changed = true;
+            if (cs->added) cs->added[cs->added_count++] = next->nodes[i]->id;
+        }
+        return true;
+    }
+
+    for (int i = 0; i < next->count; i++) {
+        entity_node_t *node = next->nodes[i];
+        const entity_node_t *old = entity_list_find_by_id(prev, node->id);
+        if (!old) {
+            node->changed = true;
+            cs->added[cs->added_count++] = node->id;
+            continue;
+        }
+
+        node->expanded = old->expanded;  // UI state survives any change
+        if (old->signature != node->signature) {
+            node->changed = true;
+            cs->modified[cs->modified_count++] = node->id;
+            continue;
+        }
+
+        // Unchanged: reuse everything derived from it last time
+        node->changed = false;
+        node->entity_class = old->entity_class;
+        node->class_detail = old->class_detail;  // literal or interned tag
+        node->has_component_info = old->has_component_info;
+        node->component_entity_count = old->component_entity_count;
+        node->component_size = old->component_size;
+        node->system_match_count = old->system_match_count;
+        node->disabled = old->disabled;
+    }
+
+    for (int i = 0; i < prev->count; i++) {
+        uint64_t id = prev->nodes[i]->id;
+        if (!entity_list_find_by_id(next, id)) {
+            cs->removed[cs->removed_count++] = id;
+        }
+    }
+
+    return cs->added_count > 0 || cs->modified_count > 0 ||
+           cs->removed_count > 0;
 }
 
 /* --- Entity detail --- */
@@ -122,9 +529,52 @@ void system_registry_free(system_registry_t *reg) {
         free(reg->systems[i].phase);
     }
     free(reg->systems);
+    free(reg->segments);
+    metric_window_set_fini(&reg->windows);
+    free(reg->raw_json);
     free(reg);
 }
 
+system_registry_t *system_registry_clone(const system_registry_t *reg) {
+    if (!reg) return NULL;
+    system_registry_t *copy = system_registry_create();
+    if (!copy) return NULL;
+
+    if (!metric_window_set_copy(&copy->windows, &reg->windows) ||
+        (reg->raw_json && !(copy->raw_json = strdup(reg->raw_json)))) {
+        system_registry_free(copy);
+        return NULL;
+    }
+    if (reg->count > 0) {
+        copy->systems = calloc((size_t)reg->count, sizeof(system_info_t));
+        if (!copy->systems) {
+            system_registry_free(copy);
+            return NULL;
+        }
+    }
+    if (reg->segment_count > 0) {
+        copy->segments = malloc((size_t)reg->segment_count * sizeof(pipeline_segment_t));
+        if (!copy->segments) {
+            system_registry_free(copy);
+            return NULL;
+        }
+        memcpy(copy->segments, reg->segments,
+               (size_t)reg->segment_count * sizeof(pipeline_segment_t));
+        copy->segment_count = reg->segment_count;
+    }
+
+    for (int i = 0; i < reg->count; i++) {
+        const system_info_t *si = &reg->systems[i];
+        system_info_t *di = &copy->systems[i];
+        *di = *si;
+        di->name = si->name ? strdup(si->name) : NULL;
+        di->full_path = si->full_path ? strdup(si->full_path) : NULL;
+        di->phase = si->phase ? strdup(si->phase) : NULL;
+        copy->count++;
+    }
+    return copy;
+}
+
 /* --- Test report --- */
 
 test_report_t *test_report_create(void) {
@@ -3,6 +3,10 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+
+#include "arena.h"
+#include "hash_map.h"
+#include "intern.h"
 #include <string.h>
 #include <yyjson.h>
 
@@ -11,6 +15,26 @@ static inline bool is_hidden_component(const char *name) {
     return name && strncmp(name, "flecs.doc.", 10) == 0;
 }
 
+// One stats metric: flecs' full sample window, oldest first.
+// avg/min/max each hold window_len values (see metric_window_set_t).
+typedef struct metric_window {
+    intern_id_t name;       // e.g. "performance.frame_time"
+    double *avg;
+    double *min;
+    double *max;
+} metric_window_t;
+
+// Every metric window of one stats response, in response order. Values
+// live in one block owned by the set. Fed into metric_history_t.
+typedef struct metric_window_set {
+    metric_window_t *metrics;
+    int count;
+    int window_len;         // samples per metric (60 for flecs)
+    double *values;         // backing store: count * 3 * window_len
+} metric_window_set_t;
+
+void metric_window_set_fini(metric_window_set_t *set);
+
 // Snapshot of /stats/world response
 // Each poll produces a new snapshot; previous is freed atomically
 typedef struct world_snapshot {
@@ -19,11 +43,36 @@ typedef struct world_snapshot {
     double frame_time_ms;   // performance.frame_time converted to ms
     double system_count;
     int64_t timestamp_ms;   // when this snapshot was taken
+    metric_window_set_t windows; // every gauge/counter in the response
+    char *raw_json;         // response body, only kept while spikes are armed
 } world_snapshot_t;
 
 world_snapshot_t *world_snapshot_create(void);
 void world_snapshot_free(world_snapshot_t *snap);
 
+// Deep copy (windows and raw JSON included). NULL on allocation failure.
+world_snapshot_t *world_snapshot_clone(const world_snapshot_t *snap);
+
+// Bit positions in entity_node_t.tag_bits: the well-known tags and
+// components classification tests. They match by exact name: a tag that
+// merely contains "flecs.system.System" does not make an entity a system.
+// Any other tag is only found through tag_ids.
+enum {
+    TAG_BIT_COMPONENT,        // has the "Component" component
+    TAG_BIT_SYSTEM,           // flecs.system.System
+    TAG_BIT_OBSERVER,         // flecs.core.Observer
+    TAG_BIT_PHASE_FIRST,      // builtin phases, same order as INTERN_TAG_PHASE_*
+    TAG_BIT_CUSTOM_PHASE = TAG_BIT_PHASE_FIRST +
+        (INTERN_TAG_PHASE_POSTFRAME - INTERN_TAG_PHASE_ONSTART + 1),
+                              // any other flecs.pipeline.* tag
+    TAG_BIT_COUNT
+};
+_Static_assert(TAG_BIT_COUNT <= 64, "tag bits must fit entity_node_t.tag_bits");
+
+#define TAG_BIT(b) (UINT64_C(1) << (b))
+#define TAG_MASK_BUILTIN_PHASES \
+    (((UINT64_C(1) << (TAG_BIT_CUSTOM_PHASE - TAG_BIT_PHASE_FIRST)) - 1) << TAG_BIT_PHASE_FIRST)
+
 // Entity classification -- sections spell CELS + Systems + Components
 typedef enum {
     ENTITY_CLASS_COMPOSITION,  // C: scene structure (AppUI, MainMenu, Button trees)
@@ -37,41 +86,123 @@ typedef enum {
 
 // Entity tree node (from /query response)
 // Each node represents one entity with its parent-child relationships.
-// Children array uses dynamic capacity (doubled on grow).
+// The node, its strings and its children array live in the owning
+// entity_list_t's arena; none of them are freed individually.
 typedef struct entity_node {
     char *name;             // entity leaf name, NULL for anonymous
     char *full_path;        // slash-separated for REST URL (e.g., "Sun/Earth")
     uint64_t id;            // numeric entity ID
 
-    char **component_names; // from lightweight list poll
+    intern_id_t *component_ids; // interned names, from lightweight list poll
     int component_count;
 
-    char **tags;
+    intern_id_t *tag_ids;       // interned tag names
     int tag_count;
+    uint64_t tag_bits;          // TAG_BIT_* set from tag_ids/component_ids
 
     struct entity_node *parent;       // tree link
-    struct entity_node **children;
+    struct entity_node **children;    // exactly child_count entries
     int child_count;
-    int child_capacity;
 
     bool expanded;          // UI collapse state (default true for root nodes)
     bool is_anonymous;      // no name, only numeric ID
     int depth;              // nesting level for indentation
 
+    int archetype;          // index into the list's archetypes, -1 if none
+
     entity_class_t entity_class;  // section classification
-    char *class_detail;           // display label: "OnLoad", "Observer", etc.
+    const char *class_detail;     // display label: "OnLoad", "Observer", etc.
+                                  // (string literal or a tag suffix, never freed)
+
+    // Registry annotation for component entities (from /components)
+    bool has_component_info;
+    int component_entity_count;
+    int component_size;           // bytes, 0 = no type info
 
     int system_match_count;   // match count from pipeline stats, 0 if not a system
     bool disabled;            // system disabled from pipeline stats
+
+    // Reconciliation against the previous generation
+    uint64_t signature;       // hash of the polled fields (entity_node_signature)
+    bool changed;             // added or modified since the previous generation
 } entity_node_t;
 
-// Flat ownership of all entity nodes from one poll cycle
+// What changed between an entity list and the generation it replaced,
+// filled by entity_list_reconcile(). ID arrays live in the list's arena.
+typedef struct entity_change_set {
+    uint64_t *added;
+    int added_count;
+    uint64_t *removed;        // IDs only present in the previous generation
+    int removed_count;
+    uint64_t *modified;       // same id, different signature
+    int modified_count;
+    bool full;                // no previous generation: every node is added
+} entity_change_set_t;
+
+// Inverted index from component to the entities that have it, in CSR
+// form: the entities of component slot k are
+// entities[offsets[k] .. offsets[k + 1]), sorted by entity id. Arrays
+// live in the list's arena.
+typedef struct component_index {
+    u64_map_t slot_of;          // component intern id -> slot + 1
+    uint32_t *offsets;          // slot_count + 1 entries
+    entity_node_t **entities;   // one entry per (entity, component) pair
+    int slot_count;
+} component_index_t;
+
+// Another archetype one component or tag away: the table an add/remove of
+// id moves entities to
+typedef struct archetype_edge {
+    int archetype;              // index into the list's archetypes
+    intern_id_t id;             // the id the two differ in
+    bool added;                 // the other archetype has id, this one not
+    bool is_tag;
+} archetype_edge_t;
+
+// The entities sharing one exact set of components and tags -- their
+// flecs table, as far as the query reports it (pairs and the hidden
+// flecs.doc components are not polled, so tables differing only in those
+// share an archetype). ids holds the component ids, then the tag ids,
+// each run sorted. Arrays live in the list's arena.
+typedef struct archetype {
+    intern_id_t *ids;
+    int component_count;
+    int tag_count;
+    uint64_t hash;              // order-independent hash of ids
+    entity_node_t **entities;   // entity_count entries, in parse order
+    int entity_count;
+    archetype_edge_t *neighbors;    // archetypes one component or tag away
+    int neighbor_count;
+    // Filled by analysis_update from the component registry
+    int *component_sizes;       // per component id, -1 if unknown
+    int row_size;               // bytes per entity, sum of known sizes
+    int unsized_count;          // components with no size in the registry
+} archetype_t;
+
+// Flat ownership of all entity nodes from one poll cycle.
+// Nodes, strings and arrays are carved out of one arena, so freeing a
+// generation is a handful of free() calls regardless of entity count.
 typedef struct entity_list {
+    arena_t arena;          // backing memory for everything below
     entity_node_t **nodes;  // flat ownership array of all nodes
     int count;
 
     entity_node_t **roots;  // top-level nodes (pointers into nodes[])
     int root_count;
+
+    // Lookup indexes, built while parsing (keys borrowed from the nodes)
+    str_map_t by_path;      // full_path -> entity_node_t*
+    u64_map_t by_id;        // id -> entity_node_t*
+
+    // Tag bits: tag intern id -> bit + 1 (cached per distinct tag)
+    u64_map_t tag_bit_of;
+
+    component_index_t by_component;  // built once nodes[] is final
+
+    archetype_t *archetypes;         // in order of first appearance
+    int archetype_count;
+
+    entity_change_set_t changes;  // vs the previously installed list
 } entity_list_t;
 
 // Selected entity component data (from /entity/<path> response)
@@ -106,28 +237,90 @@ typedef struct component_registry {
 typedef struct system_info {
     char *name;              // leaf name (e.g., "MovementSystem")
     char *full_path;         // dot-separated path from pipeline stats
-    char *phase;             // phase name (e.g., "OnUpdate") -- filled by tab_ecs classify
+    char *phase;             // phase name (e.g., "OnUpdate") -- filled by analysis_update
     bool disabled;           // from pipeline stats
     int matched_entity_count; // latest gauge value
     int matched_table_count;  // latest gauge value
     double time_spent_ms;    // latest gauge value, converted to ms
+    // Summary of the time_spent window (the latest value without one);
+    // the full windows are in the registry's windows set
+    double time_avg_ms;      // mean of the time_spent avg window
+    double time_worst_ms;    // largest time_spent max in the window
 } system_info_t;
 
+// One pipeline segment: the run of systems flecs executes between two
+// sync points, plus the sync point (merge) that ends it. Parsed from the
+// /stats/pipeline entries carrying "system_count", which follow the
+// systems of their segment. Systems after the last sync point form a
+// trailing segment without one (has_sync = false).
+typedef struct pipeline_segment {
+    int first_system;        // index into system_registry_t.systems
+    int system_count;        // systems of this segment in the response
+    int reported_count;      // system_count as reported by flecs
+    bool has_sync;
+    bool multi_threaded;
+    bool immediate;
+    double systems_ms;       // sum of the systems' latest time_spent
+    double sync_ms;          // latest sync time_spent, converted to ms
+    double sync_avg_ms;      // mean of the sync time_spent avg window
+    double sync_worst_ms;    // largest sync time_spent max in the window
+    double commands_enqueued; // latest gauge value
+} pipeline_segment_t;
+
 // All systems from one /stats/pipeline poll
 typedef struct system_registry {
     system_info_t *systems;
     int count;
+    pipeline_segment_t *segments; // in execution order, systems interleaved
+    int segment_count;
+    metric_window_set_t windows; // "<full_path>.<metric>" for every system,
+                                 // "sync.<n>.<metric>" for every sync point
+    char *raw_json;         // response body, only kept while spikes are armed
 } system_registry_t;
 
 // Entity node lifecycle
-entity_node_t *entity_node_create(void);
-void entity_node_free(entity_node_t *node);
-void entity_node_add_child(entity_node_t *parent, entity_node_t *child);
-
-// Entity list lifecycle
-entity_list_t *entity_list_create(void);
+// Entity list lifecycle. arena_hint sizes the first arena chunk (e.g. the
+// JSON body length); 0 picks a small default.
+entity_list_t *entity_list_create(size_t arena_hint);
 void entity_list_free(entity_list_t *list);
 
+// Allocate a zeroed node from the list's arena (expanded = true).
+entity_node_t *entity_list_new_node(entity_list_t *list);
+
+// O(1) lookups through the list's indexes. Return NULL if not found.
+entity_node_t *entity_list_find_by_path(const entity_list_t *list, const char *path);
+entity_node_t *entity_list_find_by_id(const entity_list_t *list, uint64_t id);
+
+// Set node->tag_bits from its tag and component ids. Called by the parser
+// per node.
+void entity_list_index_tags(entity_list_t *list, entity_node_t *node);
+
+// Build list->by_component from nodes[]. Returns false on allocation
+// failure (the index is then empty).
+bool entity_list_build_component_index(entity_list_t *list);
+
+// Entities with a component, sorted by id; *count receives their number.
+// NULL with *count = 0 if no entity has it. O(1).
+entity_node_t *const *entity_list_with_component(const entity_list_t *list,
+                                                 intern_id_t component, int *count);
+
+// Group nodes[] into archetypes, setting node->archetype and the
+// neighbor counts (row sizes are left to analysis_update). Returns false
+// on allocation failure (the list then has no archetypes).
+bool entity_list_build_archetypes(entity_list_t *list);
+
+// Hash of everything a poll reports about a node (path, components, tags,
+// child count). Equal signatures mean nothing derived from the node
+// needs recomputing.
+uint64_t entity_node_signature(const entity_node_t *node);
+
+// Diff next against prev (may be NULL) by entity id and fill next->changes.
+// Nodes with an unchanged signature take over prev's derived state
+// (classification, annotations); every matched node keeps its expand state.
+// Returns false if next holds the same entities as prev (order aside), in
+// which case the caller can keep prev and drop next.
+bool entity_list_reconcile(entity_list_t *next, const entity_list_t *prev);
+
 // Entity detail lifecycle
 entity_detail_t *entity_detail_create(void);
 void entity_detail_free(entity_detail_t *detail);
@@ -140,6 +333,9 @@ void component_registry_free(component_registry_t *reg);
 system_registry_t *system_registry_create(void);
 void system_registry_free(system_registry_t *reg);
 
+// Deep copy (systems, windows and raw JSON). NULL on allocation failure.
+system_registry_t *system_registry_clone(const system_registry_t *reg);
+
 // Single test result (from tests/output/latest.json)
 typedef struct test_result {
     char *suite;             // e.g., "CelsFixture", "bench", "utility"
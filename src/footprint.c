@@ -0,0 +1,118 @@
+#define _POSIX_C_SOURCE 200809L
+#include "footprint.h"
+#include <stdlib.h>
+#include <string.h>
+
+void footprint_tracker_fini(footprint_tracker_t *t) {
+    free(t->series);
+    u64_map_fini(&t->by_name);
+    memset(t, 0, sizeof(*t));
+}
+
+/* Series for a name, created on first sight (NULL on allocation failure) */
+static footprint_series_t *series_for(footprint_tracker_t *t, intern_id_t name) {
+    uintptr_t slot = (uintptr_t)u64_map_get(&t->by_name, name);
+    if (slot != 0) return &t->series[slot - 1];
+
+    if (t->count == t->capacity) {
+        int cap = t->capacity == 0 ? 64 : t->capacity * 2;
+        footprint_series_t *grown = realloc(t->series, (size_t)cap * sizeof(*grown));
+        if (!grown) return NULL;
+        t->series = grown;
+        t->capacity = cap;
+    }
+    if (!u64_map_put(&t->by_name, name, (void *)(uintptr_t)(t->count + 1))) return NULL;
+
+    footprint_series_t *s = &t->series[t->count++];
+    memset(s, 0, sizeof(*s));
+    s->name = name;
+    s->first_seq = t->seq;
+    return s;
+}
+
+/* Record this sample's value and update the growth streak */
+static void series_push(footprint_series_t *s, uint64_t seq, uint64_t bytes) {
+    if (seq == s->first_seq) {
+        s->first_bytes = bytes;
+    } else if (bytes > s->bytes) {
+        s->rises++;
+    } else if (bytes < s->bytes) {
+        s->rises = 0;
+    }
+    s->bytes = bytes;
+    if (bytes > s->peak_bytes) s->peak_bytes = bytes;
+    s->ring[seq % FOOTPRINT_HISTORY] = bytes;
+}
+
+bool footprint_tracker_ingest(footprint_tracker_t *t, const component_registry_t *reg,
+                              int64_t now_ms) {
+    bool ok = true;
+    uint64_t seq = t->seq;
+
+    /* Components absent from this registry drop to zero */
+    for (int i = 0; i < t->count; i++) {
+        t->series[i].size = 0;
+        t->series[i].entity_count = 0;
+    }
+    uint64_t *bytes = calloc((size_t)(t->count + reg->count + 1), sizeof(uint64_t));
+    if (!bytes) return false;
+
+    for (int r = 0; r < reg->count; r++) {
+        const component_info_t *ci = &reg->components[r];
+        intern_id_t name = ci->name ? intern(ci->name) : INTERN_NONE;
+        if (name == INTERN_NONE) continue;
+        footprint_series_t *s = series_for(t, name);
+        if (!s) {
+            ok = false;
+            continue;
+        }
+        s->size = ci->has_type_info ? ci->size : 0;
+        s->entity_count = ci->entity_count;
+        if (ci->entity_count > 0) {
+            bytes[s - t->series] += (uint64_t)s->size * (uint64_t)ci->entity_count;
+        }
+    }
+
+    uint64_t total = 0;
+    for (int i = 0; i < t->count; i++) {
+        series_push(&t->series[i], seq, bytes[i]);
+        total += bytes[i];
+    }
+    free(bytes);
+
+    if (seq == 0) {
+        t->first_ms = now_ms;
+        t->first_total_bytes = total;
+    }
+    t->last_ms = now_ms;
+    t->total_bytes = total;
+    if (total > t->peak_total_bytes) t->peak_total_bytes = total;
+    t->total_ring[seq % FOOTPRINT_HISTORY] = total;
+    t->seq = seq + 1;
+    return ok;
+}
+
+const footprint_series_t *footprint_tracker_find(const footprint_tracker_t *t,
+                                                 intern_id_t name) {
+    uintptr_t slot = (uintptr_t)u64_map_get(&t->by_name, name);
+    return slot != 0 ? &t->series[slot - 1] : NULL;
+}
+
+bool footprint_series_growing(const footprint_series_t *s) {
+    return s->rises >= FOOTPRINT_GROWTH_RISES;
+}
+
+int footprint_tracker_recent(const footprint_tracker_t *t, const footprint_series_t *s,
+                             uint64_t *out, int max) {
+    uint64_t first = s ? s->first_seq : 0;
+    uint64_t avail = t->seq - first;
+    if (avail > FOOTPRINT_HISTORY) avail = FOOTPRINT_HISTORY;
+    if ((uint64_t)max > avail) max = (int)avail;
+
+    const uint64_t *ring = s ? s->ring : t->total_ring;
+    for (int i = 0; i < max; i++) {
+        uint64_t seq = t->seq - (uint64_t)max + (uint64_t)i;
+        out[i] = ring[seq % FOOTPRINT_HISTORY];
+    }
+    return max;
+}
@@ -0,0 +1,75 @@
+#ifndef CELS_DEBUG_FOOTPRINT_H
+#define CELS_DEBUG_FOOTPRINT_H
+
+#include "data_model.h"
+#include "hash_map.h"
+#include "intern.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Component memory footprint over a session.
+ *
+ * Every /components registry the poller delivers is one sample: each
+ * component's footprint is its type size times its entity count, which
+ * is the column data flecs stores for it (table overhead, sparse storage
+ * and heap data owned by the component are not included). The last
+ * FOOTPRINT_HISTORY samples are kept per component, together with the
+ * first and peak value. A component whose footprint rose at least
+ * FOOTPRINT_GROWTH_RISES times without ever falling in between is flagged
+ * as growing -- a cheap leak/bloat signal. The poller skips unchanged
+ * responses, so samples mark changes rather than a fixed clock.
+ * Owned by the UI thread. */
+
+#define FOOTPRINT_HISTORY       64
+#define FOOTPRINT_GROWTH_RISES  4
+
+typedef struct footprint_series {
+    intern_id_t name;               /* component name, e.g. "game.Position" */
+    int         size;               /* latest type size, 0 = no type info */
+    int         entity_count;       /* latest */
+    uint64_t    bytes;              /* latest footprint */
+    uint64_t    first_bytes;        /* footprint when first seen */
+    uint64_t    peak_bytes;
+    uint64_t    first_seq;          /* first sample the component was in */
+    int         rises;              /* increases since the last decrease */
+    uint64_t    ring[FOOTPRINT_HISTORY];  /* bytes per sample, by seq */
+} footprint_series_t;
+
+typedef struct footprint_tracker {
+    footprint_series_t *series;     /* in order of first appearance */
+    int                 count;
+    int                 capacity;
+    u64_map_t           by_name;    /* intern id -> series index + 1 */
+    uint64_t            seq;        /* samples taken */
+    int64_t             first_ms;   /* timestamp of the first sample */
+    int64_t             last_ms;
+    uint64_t            total_bytes;
+    uint64_t            first_total_bytes;
+    uint64_t            peak_total_bytes;
+    uint64_t            total_ring[FOOTPRINT_HISTORY];
+} footprint_tracker_t;
+
+/* A zeroed tracker is empty and ready; fini releases it. */
+void footprint_tracker_fini(footprint_tracker_t *t);
+
+/* Take one sample from a registry. Components missing from it count as
+ * zero bytes. Returns false on allocation failure (the sample is still
+ * taken for the components already tracked). */
+bool footprint_tracker_ingest(footprint_tracker_t *t, const component_registry_t *reg,
+                              int64_t now_ms);
+
+/* Series of a component, or NULL if it never appeared. */
+const footprint_series_t *footprint_tracker_find(const footprint_tracker_t *t,
+                                                 intern_id_t name);
+
+/* Growing as defined above. */
+bool footprint_series_growing(const footprint_series_t *s);
+
+/* Copy up to max of a series' most recent samples into out, oldest
+ * first (only samples since it first appeared). NULL s copies the world
+ * total. Returns the count. */
+int footprint_tracker_recent(const footprint_tracker_t *t, const footprint_series_t *s,
+                             uint64_t *out, int max);
+
+#endif /* CELS_DEBUG_FOOTPRINT_H */
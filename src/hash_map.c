@@ -0,0 +1,189 @@
+#include "hash_map.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* --- Hashing --- */
+
+#define HASH_PRIME_1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME_2 0xC2B2AE3D27D4EB4FULL
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+uint64_t hash_u64(uint64_t k) {
+    /* murmur3 fmix64 */
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33;
+    k *= 0xC4CEB9FE1A85EC53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+uint64_t hash_bytes(const void *data, size_t len) {
+    const unsigned char *p = (const unsigned char *)data;
+    uint64_t h = HASH_PRIME_1 ^ (uint64_t)len;
+
+    while (len >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);  /* unaligned-safe, compiles to a single load */
+        h ^= rotl64(w * HASH_PRIME_2, 31) * HASH_PRIME_1;
+        h = rotl64(h, 27) * HASH_PRIME_1 + HASH_PRIME_2;
+        p += 8;
+        len -= 8;
+    }
+
+    uint64_t tail = 0;
+    for (size_t i = 0; i < len; i++) {
+        tail |= (uint64_t)p[i] << (8 * i);
+    }
+    h ^= rotl64(tail * HASH_PRIME_2, 31) * HASH_PRIME_1;
+
+    return hash_u64(h);
+}
+
+/* Smallest power of two keeping the load factor at or below 1/2 */
+static size_t capacity_for(size_t expected) {
+    size_t cap = 16;
+    while (cap < expected * 2) cap <<= 1;
+    return cap;
+}
+
+/* --- String keys --- */
+
+bool str_map_init(str_map_t *m, size_t expected) {
+    size_t cap = capacity_for(expected);
+    m->slots = calloc(cap, sizeof(str_map_slot_t));
+    if (!m->slots) {
+        m->capacity = 0;
+        m->count = 0;
+        return false;
+    }
+    m->capacity = cap;
+    m->count = 0;
+    return true;
+}
+
+void str_map_fini(str_map_t *m) {
+    free(m->slots);
+    m->slots = NULL;
+    m->capacity = 0;
+    m->count = 0;
+}
+
+static str_map_slot_t *str_map_find_slot(str_map_slot_t *slots, size_t cap,
+                                         uint64_t hash, const char *key,
+                                         size_t len) {
+    size_t mask = cap - 1;
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask) {
+        str_map_slot_t *s = &slots[i];
+        if (!s->value) return s;
+        if (s->hash == hash && s->len == len && memcmp(s->key, key, len) == 0) {
+            return s;
+        }
+    }
+}
+
+static bool str_map_grow(str_map_t *m) {
+    size_t new_cap = m->capacity ? m->capacity * 2 : 16;
+    str_map_slot_t *slots = calloc(new_cap, sizeof(str_map_slot_t));
+    if (!slots) return false;
+
+    for (size_t i = 0; i < m->capacity; i++) {
+        str_map_slot_t *old = &m->slots[i];
+        if (!old->value) continue;
+        *str_map_find_slot(slots, new_cap, old->hash, old->key, old->len) = *old;
+    }
+    free(m->slots);
+    m->slots = slots;
+    m->capacity = new_cap;
+    return true;
+}
+
+bool str_map_put(str_map_t *m, const char *key, size_t len, void *value) {
+    if (!value) return false;
+    if ((m->count + 1) * 2 > m->capacity && !str_map_grow(m)) return false;
+
+    uint64_t hash = hash_bytes(key, len);
+    str_map_slot_t *s = str_map_find_slot(m->slots, m->capacity, hash, key, len);
+    if (!s->value) {
+        s->hash = hash;
+        s->key = key;
+        s->len = len;
+        m->count++;
+    }
+    s->value = value;
+    return true;
+}
+
+void *str_map_get(const str_map_t *m, const char *key, size_t len) {
+    if (m->count == 0) return NULL;
+    uint64_t hash = hash_bytes(key, len);
+    return str_map_find_slot(m->slots, m->capacity, hash, key, len)->value;
+}
+
+/* --- Integer keys --- */
+
+bool u64_map_init(u64_map_t *m, size_t expected) {
+    size_t cap = capacity_for(expected);
+    m->slots = calloc(cap, sizeof(u64_map_slot_t));
+    if (!m->slots) {
+        m->capacity = 0;
+        m->count = 0;
+        return false;
+    }
+    m->capacity = cap;
+    m->count = 0;
+    return true;
+}
+
+void u64_map_fini(u64_map_t *m) {
+    free(m->slots);
+    m->slots = NULL;
+    m->capacity = 0;
+    m->count = 0;
+}
+
+static u64_map_slot_t *u64_map_find_slot(u64_map_slot_t *slots, size_t cap,
+                                         uint64_t key) {
+    size_t mask = cap - 1;
+    for (size_t i = (size_t)hash_u64(key) & mask;; i = (i + 1) & mask) {
+        u64_map_slot_t *s = &slots[i];
+        if (!s->value || s->key == key) return s;
+    }
+}
+
+static bool u64_map_grow(u64_map_t *m) {
+    size_t new_cap = m->capacity ? m->capacity * 2 : 16;
+    u64_map_slot_t *slots = calloc(new_cap, sizeof(u64_map_slot_t));
+    if (!slots) return false;
+
+    for (size_t i = 0; i < m->capacity; i++) {
+        u64_map_slot_t *old = &m->slots[i];
+        if (!old->value) continue;
+        *u64_map_find_slot(slots, new_cap, old->key) = *old;
+    }
+    free(m->slots);
+    m->slots = slots;
+    m->capacity = new_cap;
+    return true;
+}
+
+bool u64_map_put(u64_map_t *m, uint64_t key, void *value) {
+    if (!value) return false;
+    if ((m->count + 1) * 2 > m->capacity && !u64_map_grow(m)) return false;
+
+    u64_map_slot_t *s = u64_map_find_slot(m->slots, m->capacity, key);
+    if (!s->value) {
+        s->key = key;
+        m->count++;
+    }
+    s->value = value;
+    return true;
+}
+
+void *u64_map_get(const u64_map_t *m, uint64_t key) {
+    if (m->count == 0) return NULL;
+    return u64_map_find_slot(m->slots, m->capacity, key)->value;
+}
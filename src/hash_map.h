@@ -0,0 +1,65 @@
+#ifndef CELS_DEBUG_HASH_MAP_H
+#define CELS_DEBUG_HASH_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Open-addressing hash maps (linear probing, power-of-two capacity).
+ *
+ * Built once per poll generation and then only read, so there is no
+ * removal. Keys are borrowed: a str_map_t stores the caller's pointer, which
+ * must outlive the map. Values must be non-NULL -- a NULL value marks an
+ * empty slot, and lookups return NULL for "not found". */
+
+/* Fast 64-bit hash over arbitrary bytes (8 bytes per step). */
+uint64_t hash_bytes(const void *data, size_t len);
+
+/* Finalizer mix for integer keys. */
+uint64_t hash_u64(uint64_t key);
+
+/* --- String keys --- */
+
+typedef struct str_map_slot {
+    uint64_t    hash;
+    const char *key;     /* borrowed, not necessarily NUL-terminated at len */
+    size_t      len;
+    void       *value;   /* NULL = empty slot */
+} str_map_slot_t;
+
+typedef struct str_map {
+    str_map_slot_t *slots;
+    size_t          capacity;  /* 0 or a power of two */
+    size_t          count;
+} str_map_t;
+
+/* Size the table for `expected` entries without rehashing. Returns false
+ * on allocation failure. A zeroed str_map_t is a valid empty map. */
+bool str_map_init(str_map_t *m, size_t expected);
+void str_map_fini(str_map_t *m);
+
+/* Insert or replace. Grows as needed; returns false on allocation failure. */
+bool str_map_put(str_map_t *m, const char *key, size_t len, void *value);
+
+/* Look up the first len bytes of key, or NULL if absent. */
+void *str_map_get(const str_map_t *m, const char *key, size_t len);
+
+/* --- Integer keys --- */
+
+typedef struct u64_map_slot {
+    uint64_t key;
+    void    *value;      /* NULL = empty slot */
+} u64_map_slot_t;
+
+typedef struct u64_map {
+    u64_map_slot_t *slots;
+    size_t          capacity;  /* 0 or a power of two */
+    size_t          count;
+} u64_map_t;
+
+bool u64_map_init(u64_map_t *m, size_t expected);
+void u64_map_fini(u64_map_t *m);
+bool u64_map_put(u64_map_t *m, uint64_t key, void *value);
+void *u64_map_get(const u64_map_t *m, uint64_t key);
+
+#endif /* CELS_DEBUG_HASH_MAP_H */
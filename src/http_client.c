@@ -1,40 +1,101 @@
+#define _POSIX_C_SOURCE 200809L
 #include "http_client.h"
+#include "hash_map.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
+
+// Make room for need body bytes plus the zero padding. Doubles, so a
+// buffer that is reused across responses settles at its peak size.
+static bool buffer_reserve(http_buffer_t *buf, size_t need) {
+    if (need > SIZE_MAX / 2 - HTTP_BODY_PADDING) return false;
+    if (need + HTTP_BODY_PADDING <= buf->capacity) return true;
+
+    size_t cap = buf->capacity ? buf->capacity : 4096;
+    while (cap < need + HTTP_BODY_PADDING) cap *= 2;
+    char *new_data = realloc(buf->data, cap);
+    if (!new_data) return false;
+    buf->data = new_data;
+    buf->capacity = cap;
+    return true;
+}
 
 static size_t write_callback(char *ptr, size_t size, size_t nmemb, void *userdata) {
     size_t total = size * nmemb;
     http_buffer_t *buf = (http_buffer_t *)userdata;
 
-    char *new_data = realloc(buf->data, buf->size + total + 1);
-    if (!new_data) return 0;
+    if (!buffer_reserve(buf, buf->size + total)) return 0;
 
-    buf->data = new_data;
     memcpy(buf->data + buf->size, ptr, total);
     buf->size += total;
-    buf->data[buf->size] = '\0';
+    memset(buf->data + buf->size, 0, HTTP_BODY_PADDING);
 
     return total;
 }
 
-CURL *http_client_init(void) {
-    curl_global_init(CURL_GLOBAL_DEFAULT);
-    CURL *curl = curl_easy_init();
-    if (!curl) return NULL;
+// Value of a "Name: value" header line if it matches name, trimmed
+static const char *header_value(const char *line, size_t len, const char *name,
+                                size_t *out_len) {
+    size_t nlen = strlen(name);
+    if (len <= nlen || strncasecmp(line, name, nlen) != 0) return NULL;
+    const char *v = line + nlen;
+    size_t n = len - nlen;
+    while (n > 0 && (*v == ' ' || *v == '\t')) { v++; n--; }
+    while (n > 0 && (v[n - 1] == '\r' || v[n - 1] == '\n' || v[n - 1] == ' ')) n--;
+    *out_len = n;
+    return v;
+}
+
+// Multi slots: pre-size the receive buffer from Content-Length and capture
+// the ETag (userdata is the http_slot_t)
+static size_t header_callback(char *ptr, size_t size, size_t nmemb, void *userdata) {
+    size_t total = size * nmemb;
+    http_slot_t *slot = (http_slot_t *)userdata;
+    size_t n;
+    const char *v;
 
+    if ((v = header_value(ptr, total, "Content-Length:", &n)) != NULL) {
+        char digits[24];
+        if (n > 0 && n < sizeof(digits)) {
+            memcpy(digits, v, n);
+            digits[n] = '\0';
+            unsigned long long length = strtoull(digits, NULL, 10);
+            // Only a hint -- a bogus value must not trigger a huge allocation
+            if (length > 0 && length <= (64ull << 20)) {
+                buffer_reserve(&slot->buf, (size_t)length);
+            }
+        }
+    } else if ((v = header_value(ptr, total, "ETag:", &n)) != NULL) {
+        if (n > 0 && n < HTTP_ETAG_MAX) {
+            memcpy(slot->etag_received, v, n);
+            slot->etag_received[n] = '\0';
+        }
+    }
+    return total;
+}
+
+static void configure_easy(CURL *curl) {
     // Short timeouts -- localhost only, sub-ms round trip expected
     curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, 200L);
     curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, 200L);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
     // Prevent libcurl from installing its own signal handlers
     curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+}
 
+CURL *http_client_init(void) {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    CURL *curl = curl_easy_init();
+    if (!curl) return NULL;
+
+    configure_easy(curl);
     return curl;
 }
 
 http_response_t http_get(CURL *curl, const char *url) {
     http_response_t resp = {0};
-    http_buffer_t buf = {NULL, 0};
+    http_buffer_t buf = {NULL, 0, 0};
 
     curl_easy_setopt(curl, CURLOPT_URL, url);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &buf);
@@ -45,6 +106,9 @@ http_response_t http_get(CURL *curl, const char *url) {
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
         resp.status = (int)http_code;
         resp.body = buf;
+        if (resp.status == 200 && buf.data) {
+            resp.body_hash = hash_bytes(buf.data, buf.size);
+        }
     } else {
         resp.status = -1;
         free(buf.data);
@@ -57,6 +121,7 @@ void http_response_free(http_response_t *resp) {
     free(resp->body.data);
     resp->body.data = NULL;
     resp->body.size = 0;
+    resp->body.capacity = 0;
 }
 
 void http_client_fini(CURL *curl) {
@@ -64,8 +129,202 @@ void http_client_fini(CURL *curl) {
     curl_global_cleanup();
 }
 
+/* --- Multi (concurrent) requests --- */
+
+http_multi_t *http_multi_init(int slot_count) {
+    if (slot_count <= 0 || slot_count > HTTP_MULTI_MAX_SLOTS) return NULL;
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    http_multi_t *m = calloc(1, sizeof(http_multi_t));
+    if (!m) return NULL;
+
+    m->multi = curl_multi_init();
+    if (!m->multi) {
+        free(m);
+        return NULL;
+    }
+    m->slot_count = slot_count;
+
+    for (int i = 0; i < slot_count; i++) {
+        http_slot_t *s = &m->slot[i];
+        s->easy = curl_easy_init();
+        if (!s->easy) {
+            http_multi_fini(m);
+            return NULL;
+        }
+        configure_easy(s->easy);
+        curl_easy_setopt(s->easy, CURLOPT_WRITEDATA, &s->buf);
+        curl_easy_setopt(s->easy, CURLOPT_HEADERFUNCTION, header_callback);
+        curl_easy_setopt(s->easy, CURLOPT_HEADERDATA, s);
+    }
+
+    return m;
+}
+
+bool http_multi_add(http_multi_t *m, int slot, const char *url) {
+    if (slot < 0 || slot >= m->slot_count || m->slot[slot].queued) return false;
+    http_slot_t *s = &m->slot[slot];
+
+    // The buffer (and its capacity) is kept; only the content is dropped
+    s->buf.size = 0;
+    s->resp.status = 0;
+    s->resp.body.data = NULL;
+    s->resp.body.size = 0;
+    s->resp.body_hash = 0;
+    s->etag_received[0] = '\0';
+
+    if (!s->url || strcmp(s->url, url) != 0) {
+        free(s->url);
+        s->url = strdup(url);
+    }
+
+    // Revalidate instead of refetching when we hold a validator for this URL
+    bool conditional = s->etag[0] && s->etag_url && strcmp(s->etag_url, url) == 0;
+    if (conditional && !s->headers) {
+        char line[HTTP_ETAG_MAX + 32];
+        snprintf(line, sizeof(line), "If-None-Match: %s", s->etag);
+        s->headers = curl_slist_append(NULL, line);
+    }
+    curl_easy_setopt(s->easy, CURLOPT_HTTPHEADER, conditional ? s->headers : NULL);
+    curl_easy_setopt(s->easy, CURLOPT_URL, url);
+    if (curl_multi_add_handle(m->multi, s->easy) != CURLM_OK) return false;
+    s->queued = true;
+    return true;
+}
+
+void http_multi_forget(http_multi_t *m, int slot) {
+    if (slot < 0 || slot >= m->slot_count) return;
+    http_slot_t *s = &m->slot[slot];
+    s->etag[0] = '\0';
+    free(s->etag_url);
+    s->etag_url = NULL;
+    curl_slist_free_all(s->headers);
+    s->headers = NULL;
+}
+
+// A 200 replaces the slot's validator with whatever ETag it carried (or
+// none); a 304 keeps it; any other status invalidates it
+static void update_validator(http_multi_t *m, int slot, int status) {
+    http_slot_t *s = &m->slot[slot];
+    if (status == 304) return;
+    if (status == 200 && s->etag_received[0] && s->url &&
+        strcmp(s->etag, s->etag_received) == 0 &&
+        s->etag_url && strcmp(s->etag_url, s->url) == 0) {
+        return;  // same validator as before
+    }
+    http_multi_forget(m, slot);
+    if (status == 200 && s->etag_received[0] && s->url) {
+        memcpy(s->etag, s->etag_received, sizeof(s->etag));
+        s->etag_url = strdup(s->url);
+    }
+}
+
+// Find the slot index owning an easy handle
+static int slot_of(http_multi_t *m, CURL *easy) {
+    for (int i = 0; i < m->slot_count; i++) {
+        if (m->slot[i].easy == easy) return i;
+    }
+    return -1;
+}
+
+void http_multi_perform(http_multi_t *m) {
+    // Responses of slots outside this batch are stale
+    for (int i = 0; i < m->slot_count; i++) {
+        if (!m->slot[i].queued) {
+            m->slot[i].resp.status = 0;
+            m->slot[i].resp.body.data = NULL;
+            m->slot[i].resp.body.size = 0;
+            m->slot[i].resp.body_hash = 0;
+        }
+    }
+
+    int running = 0;
+    curl_multi_perform(m->multi, &running);
+
+    while (running > 0) {
+        // Sleeps on the transfer sockets; per-handle CURLOPT_TIMEOUT_MS
+        // bounds the whole batch
+        if (curl_multi_poll(m->multi, NULL, 0, 200, NULL) != CURLM_OK) break;
+        curl_multi_perform(m->multi, &running);
+    }
+
+    CURLMsg *msg;
+    int remaining;
+    while ((msg = curl_multi_info_read(m->multi, &remaining)) != NULL) {
+        if (msg->msg != CURLMSG_DONE) continue;
+        int slot = slot_of(m, msg->easy_handle);
+        if (slot < 0) continue;
+        http_slot_t *s = &m->slot[slot];
+
+        if (msg->data.result == CURLE_OK) {
+            long http_code = 0;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &http_code);
+            s->resp.status = (int)http_code;
+            if (s->buf.data && s->buf.size > 0) {
+                s->resp.body.data = s->buf.data;
+                s->resp.body.size = s->buf.size;
+                if (http_code == 200) {
+                    s->resp.body_hash = hash_bytes(s->buf.data, s->buf.size);
+                }
+            }
+            update_validator(m, slot, (int)http_code);
+        } else {
+            s->resp.status = -1;
+        }
+    }
+
+    // Detach every handle of this batch (including any that never
+    // reported DONE) so the slots can be queued again
+    for (int i = 0; i < m->slot_count; i++) {
+        http_slot_t *s = &m->slot[i];
+        if (!s->queued) continue;
+        curl_multi_remove_handle(m->multi, s->easy);
+        s->queued = false;
+        if (s->resp.status == 0) {
+            // Never completed -- treat as network error
+            s->resp.status = -1;
+        }
+    }
+}
+
+bool http_multi_wait(http_multi_t *m, int extra_fd, int timeout_ms) {
+    struct curl_waitfd wfd = { .fd = extra_fd, .events = CURL_WAIT_POLLIN, .revents = 0 };
+    // curl_multi_poll takes an int timeout with no "infinite" value
+    int ms = timeout_ms < 0 ? 60 * 60 * 1000 : timeout_ms;
+    if (curl_multi_poll(m->multi, extra_fd >= 0 ? &wfd : NULL,
+                        extra_fd >= 0 ? 1 : 0, ms, NULL) != CURLM_OK) {
+        return false;
+    }
+    return (wfd.revents & CURL_WAIT_POLLIN) != 0;
+}
+
+void http_multi_wakeup(http_multi_t *m) {
+    curl_multi_wakeup(m->multi);
+}
+
+http_response_t *http_multi_response(http_multi_t *m, int slot) {
+    if (slot < 0 || slot >= m->slot_count) return NULL;
+    return &m->slot[slot].resp;
+}
+
+void http_multi_fini(http_multi_t *m) {
+    if (!m) return;
+    for (int i = 0; i < m->slot_count; i++) {
+        http_slot_t *s = &m->slot[i];
+        if (!s->easy) continue;
+        if (s->queued) curl_multi_remove_handle(m->multi, s->easy);
+        curl_easy_cleanup(s->easy);
+        http_multi_forget(m, i);
+        free(s->buf.data);
+        free(s->url);
+    }
+    if (m->multi) curl_multi_cleanup(m->multi);
+    free(m);
+    curl_global_cleanup();
+}
+
 connection_state_t connection_state_update(connection_state_t current, int http_status) {
-    if (http_status == 200) {
+    if (http_status == 200 || http_status == 304) {
         return CONN_CONNECTED;
     }
     /* Once we've ever connected, always show Reconnecting on failure */
@@ -1,7 +1,9 @@
 #ifndef CELS_DEBUG_HTTP_CLIENT_H
 #define CELS_DEBUG_HTTP_CLIENT_H
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <curl/curl.h>
 
 // Connection state machine
@@ -11,16 +13,24 @@ typedef enum {
     CONN_RECONNECTING
 } connection_state_t;
 
-// HTTP response buffer
+// Zero bytes guaranteed after every received body, so parsers that read
+// in place (yyjson INSITU) can run directly on the buffer
+#define HTTP_BODY_PADDING 8
+
+// HTTP response buffer. Grows geometrically and is followed by
+// HTTP_BODY_PADDING zero bytes whenever data is non-NULL.
 typedef struct {
     char *data;
     size_t size;
+    size_t capacity;     // allocated bytes, including padding
 } http_buffer_t;
 
-// HTTP response (caller must call http_response_free)
+// HTTP response (caller must call http_response_free, except for the
+// borrowed responses returned by http_multi_response)
 typedef struct {
     int status;          // HTTP status code, or -1 on network error
     http_buffer_t body;
+    uint64_t body_hash;  // hash_bytes() of a 200 body, 0 otherwise
 } http_response_t;
 
 // Initialize libcurl (call once at startup). Returns NULL on failure.
@@ -36,9 +46,78 @@ void http_response_free(http_response_t *resp);
 // Cleanup libcurl (call once at shutdown).
 void http_client_fini(CURL *curl);
 
+// Concurrent GETs over curl_multi.
+// Each slot owns one easy handle that is reused across batches (keeps the
+// connection alive). A batch issues every queued slot at once and completes
+// when the slowest one finishes, so cycle latency is max() not sum().
+//
+// Each slot also keeps its receive buffer across batches, pre-sized from
+// Content-Length. Once a slot has seen its largest response, receiving it
+// again allocates nothing.
+//
+// Slots also remember the ETag of their last 200 response. Requesting the
+// same URL again sends If-None-Match, and an unchanged resource comes back
+// as a bodyless 304.
+#define HTTP_MULTI_MAX_SLOTS 8
+#define HTTP_ETAG_MAX        128   // longer validators are ignored
+
+typedef struct http_slot {
+    CURL *easy;
+    http_buffer_t buf;             // persistent receive buffer
+    http_response_t resp;          // finished response, body borrows buf
+    bool queued;                   // added to current batch
+    char *url;                     // URL of the current/last request
+    char etag[HTTP_ETAG_MAX];      // validator for etag_url ("" = none)
+    char *etag_url;
+    char etag_received[HTTP_ETAG_MAX]; // ETag header of the response in flight
+    struct curl_slist *headers;    // If-None-Match for etag, built lazily
+} http_slot_t;
+
+typedef struct http_multi {
+    CURLM *multi;
+    int slot_count;
+    http_slot_t slot[HTTP_MULTI_MAX_SLOTS];
+} http_multi_t;
+
+// Initialize libcurl and a multi handle with slot_count easy handles
+// (call once at startup). Returns NULL on failure.
+http_multi_t *http_multi_init(int slot_count);
+
+// Queue a GET for slot in the next batch. Conditional (If-None-Match) if
+// the slot holds an ETag for this URL. Returns false if the slot is out of
+// range or already queued.
+bool http_multi_add(http_multi_t *m, int slot, const char *url);
+
+// Drop the slot's ETag so its next request is unconditional. Use when the
+// caller no longer has the data a 304 would refer to.
+void http_multi_forget(http_multi_t *m, int slot);
+
+// Run every queued request concurrently until all have completed or timed
+// out. Afterwards each queued slot has a response ready for
+// http_multi_response; slots that were not queued report status 0.
+void http_multi_perform(http_multi_t *m);
+
+// Sleep until extra_fd becomes readable, http_multi_wakeup() is called or
+// timeout_ms elapses (-1 waits forever). Returns true if extra_fd is
+// readable. Nothing is queued between batches, so this only waits on the
+// caller's fd and the multi handle's wakeup pipe.
+bool http_multi_wait(http_multi_t *m, int extra_fd, int timeout_ms);
+
+// Interrupt http_multi_wait()/http_multi_perform() from another thread.
+// Sticky: a wakeup sent while nobody is waiting ends the next wait at once.
+void http_multi_wakeup(http_multi_t *m);
+
+// Borrow the finished response for slot (NULL if out of range). The body
+// is owned by the slot. It stays valid, and writable for in-place parsing,
+// until the slot is queued again. Do not http_response_free() it.
+http_response_t *http_multi_response(http_multi_t *m, int slot);
+
+// Cleanup easy handles, the multi handle and libcurl (call once at shutdown).
+void http_multi_fini(http_multi_t *m);
+
 // Update connection state based on HTTP result.
 // Call after each http_get to transition the state machine:
-//   status 200 -> CONNECTED
+//   status 200 (or 304 Not Modified) -> CONNECTED
 //   status != 200 && was CONNECTED/RECONNECTING -> RECONNECTING (silent retry)
 //   status != 200 && never connected -> DISCONNECTED
 connection_state_t connection_state_update(connection_state_t current, int http_status);
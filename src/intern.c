@@ -0,0 +1,233 @@
+#define _POSIX_C_SOURCE 200809L
+#include "intern.h"
+#include "arena.h"
+#include "hash_map.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Entries live in fixed-size segments that never move, so an ID can be
+ * resolved without a lock while writers append. */
+#define SEGMENT_SHIFT  12
+#define SEGMENT_SIZE   (1u << SEGMENT_SHIFT)
+#define SEGMENT_MASK   (SEGMENT_SIZE - 1)
+#define MAX_SEGMENTS   1024             /* up to 4M distinct strings */
+
+typedef struct intern_entry {
+    const char *str;
+    size_t      len;
+    uint64_t    hash;
+} intern_entry_t;
+
+/* Open-addressing index from string to ID. Published with an atomic pointer
+ * swap when it grows; the smaller predecessors stay alive (chained through
+ * `retired`) for readers still probing them, and are freed by intern_fini. */
+typedef struct intern_table {
+    struct intern_table *retired;
+    size_t               capacity;   /* power of two */
+    _Atomic intern_id_t  slots[];    /* INTERN_NONE = empty */
+} intern_table_t;
+
+/* Keep in sync with the INTERN_* enum in intern.h */
+static const char *WELL_KNOWN[INTERN_WELL_KNOWN_COUNT] = {
+    [INTERN_NONE]         = NULL,
+    [INTERN_COMPONENT]    = "Component",
+    [INTERN_TAG_SYSTEM]   = "flecs.system.System",
+    [INTERN_TAG_OBSERVER] = "flecs.core.Observer",
+    [INTERN_TAG_PHASE_ONSTART]    = "flecs.pipeline.OnStart",
+    [INTERN_TAG_PHASE_ONLOAD]     = "flecs.pipeline.OnLoad",
+    [INTERN_TAG_PHASE_POSTLOAD]   = "flecs.pipeline.PostLoad",
+    [INTERN_TAG_PHASE_PREUPDATE]  = "flecs.pipeline.PreUpdate",
+    [INTERN_TAG_PHASE_ONUPDATE]   = "flecs.pipeline.OnUpdate",
+    [INTERN_TAG_PHASE_ONVALIDATE] = "flecs.pipeline.OnValidate",
+    [INTERN_TAG_PHASE_POSTUPDATE] = "flecs.pipeline.PostUpdate",
+    [INTERN_TAG_PHASE_PRESTORE]   = "flecs.pipeline.PreStore",
+    [INTERN_TAG_PHASE_ONSTORE]    = "flecs.pipeline.OnStore",
+    [INTERN_TAG_PHASE_POSTFRAME]  = "flecs.pipeline.PostFrame",
+};
+
+static pthread_once_t          g_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t         g_lock = PTHREAD_MUTEX_INITIALIZER;  /* writers */
+static _Atomic(intern_table_t *) g_table;
+static _Atomic(intern_entry_t *) g_segments[MAX_SEGMENTS];
+static _Atomic uint32_t        g_next_id = 1;   /* ID 0 is INTERN_NONE */
+static arena_t                 g_strings;       /* canonical copies (writers only) */
+
+static intern_id_t insert_locked(const char *s, size_t len, uint64_t hash);
+
+/* --- Init --- */
+
+static intern_table_t *table_create(size_t capacity) {
+    intern_table_t *t = calloc(1, sizeof(intern_table_t) +
+                                  capacity * sizeof(_Atomic intern_id_t));
+    if (t) t->capacity = capacity;
+    return t;
+}
+
+static void init_once(void) {
+    arena_init(&g_strings, 0);
+    atomic_store(&g_table, table_create(1024));
+
+    pthread_mutex_lock(&g_lock);
+    for (int i = 1; i < INTERN_WELL_KNOWN_COUNT; i++) {
+        size_t len = strlen(WELL_KNOWN[i]);
+        insert_locked(WELL_KNOWN[i], len, hash_bytes(WELL_KNOWN[i], len));
+    }
+    pthread_mutex_unlock(&g_lock);
+}
+
+static inline void ensure_init(void) {
+    pthread_once(&g_once, init_once);
+}
+
+/* --- Lookup --- */
+
+static inline const intern_entry_t *entry_at(intern_id_t id) {
+    intern_entry_t *seg = atomic_load_explicit(&g_segments[id >> SEGMENT_SHIFT],
+                                               memory_order_acquire);
+    return &seg[id & SEGMENT_MASK];
+}
+
+/* Lock-free probe. A slot becomes non-empty only after its entry is fully
+ * written (release store in insert_locked), so any ID seen here resolves. */
+static intern_id_t table_lookup(const intern_table_t *t, const char *s,
+                                size_t len, uint64_t hash) {
+    if (!t) return INTERN_NONE;
+    size_t mask = t->capacity - 1;
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask) {
+        intern_id_t id = atomic_load_explicit(&t->slots[i], memory_order_acquire);
+        if (id == INTERN_NONE) return INTERN_NONE;
+        const intern_entry_t *e = entry_at(id);
+        if (e->hash == hash && e->len == len && memcmp(e->str, s, len) == 0) {
+            return id;
+        }
+    }
+}
+
+static void table_place(intern_table_t *t, intern_id_t id, uint64_t hash) {
+    size_t mask = t->capacity - 1;
+    size_t i = (size_t)hash & mask;
+    while (atomic_load_explicit(&t->slots[i], memory_order_relaxed) != INTERN_NONE) {
+        i = (i + 1) & mask;
+    }
+    atomic_store_explicit(&t->slots[i], id, memory_order_release);
+}
+
+/* --- Insert (caller holds g_lock) --- */
+
+static intern_table_t *grow_locked(intern_table_t *old, uint32_t count) {
+    intern_table_t *t = table_create(old->capacity * 2);
+    if (!t) return NULL;
+    for (intern_id_t id = 1; id < count; id++) {
+        table_place(t, id, entry_at(id)->hash);
+    }
+    t->retired = old;
+    atomic_store_explicit(&g_table, t, memory_order_release);
+    return t;
+}
+
+static intern_id_t insert_locked(const char *s, size_t len, uint64_t hash) {
+    intern_table_t *t = atomic_load_explicit(&g_table, memory_order_relaxed);
+    if (!t) return INTERN_NONE;
+
+    /* Another writer may have inserted it since the lock-free miss */
+    intern_id_t id = table_lookup(t, s, len, hash);
+    if (id != INTERN_NONE) return id;
+
+    uint32_t next = atomic_load_explicit(&g_next_id, memory_order_relaxed);
+    if ((next >> SEGMENT_SHIFT) >= MAX_SEGMENTS) return INTERN_NONE;
+
+    /* Keep the load factor at or below 1/2 */
+    if ((size_t)next * 2 > t->capacity) {
+        t = grow_locked(t, next);
+        if (!t) return INTERN_NONE;
+    }
+
+    intern_entry_t *seg = atomic_load_explicit(&g_segments[next >> SEGMENT_SHIFT],
+                                               memory_order_relaxed);
+    if (!seg) {
+        seg = calloc(SEGMENT_SIZE, sizeof(intern_entry_t));
+        if (!seg) return INTERN_NONE;
+        atomic_store_explicit(&g_segments[next >> SEGMENT_SHIFT], seg,
+                              memory_order_release);
+    }
+
+    char *copy = arena_strndup(&g_strings, s, len);
+    if (!copy) return INTERN_NONE;
+
+    intern_entry_t *e = &seg[next & SEGMENT_MASK];
+    e->str = copy;
+    e->len = len;
+    e->hash = hash;
+
+    table_place(t, next, hash);
+    atomic_store_explicit(&g_next_id, next + 1, memory_order_release);
+    return next;
+}
+
+/* --- Public API --- */
+
+intern_id_t intern_n(const char *s, size_t len) {
+    if (!s) return INTERN_NONE;
+    ensure_init();
+
+    uint64_t hash = hash_bytes(s, len);
+    intern_id_t id = table_lookup(atomic_load_explicit(&g_table, memory_order_acquire),
+                                  s, len, hash);
+    if (id != INTERN_NONE) return id;
+
+    pthread_mutex_lock(&g_lock);
+    id = insert_locked(s, len, hash);
+    pthread_mutex_unlock(&g_lock);
+    return id;
+}
+
+intern_id_t intern(const char *s) {
+    if (!s) return INTERN_NONE;
+    return intern_n(s, strlen(s));
+}
+
+intern_id_t intern_find(const char *s) {
+    if (!s) return INTERN_NONE;
+    ensure_init();
+
+    size_t len = strlen(s);
+    uint64_t hash = hash_bytes(s, len);
+    intern_id_t id = table_lookup(atomic_load_explicit(&g_table, memory_order_acquire),
+                                  s, len, hash);
+    if (id != INTERN_NONE) return id;
+
+    /* A miss may race a concurrent grow -- confirm under the lock */
+    pthread_mutex_lock(&g_lock);
+    id = table_lookup(atomic_load_explicit(&g_table, memory_order_relaxed), s, len, hash);
+    pthread_mutex_unlock(&g_lock);
+    return id;
+}
+
+const char *intern_str(intern_id_t id) {
+    if (id == INTERN_NONE) return NULL;
+    ensure_init();
+    if (id >= atomic_load_explicit(&g_next_id, memory_order_acquire)) return NULL;
+    return entry_at(id)->str;
+}
+
+uint32_t intern_count(void) {
+    ensure_init();
+    return atomic_load_explicit(&g_next_id, memory_order_acquire) - 1;
+}
+
+void intern_fini(void) {
+    intern_table_t *t = atomic_exchange(&g_table, NULL);
+    while (t) {
+        intern_table_t *older = t->retired;
+        free(t);
+        t = older;
+    }
+    for (int i = 0; i < MAX_SEGMENTS; i++) {
+        free(atomic_exchange(&g_segments[i], NULL));
+    }
+    arena_free(&g_strings);
+    atomic_store(&g_next_id, 1);
+}
@@ -0,0 +1,61 @@
+#ifndef CELS_DEBUG_INTERN_H
+#define CELS_DEBUG_INTERN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Process-wide string intern table.
+ *
+ * Maps each distinct string (component names, tags, ...) to a small, stable
+ * integer ID and one canonical copy. Two interned strings are equal iff
+ * their IDs are equal, so hot-path comparisons are integer compares and
+ * every entity shares the same few hundred strings.
+ *
+ * Thread safety: intern()/intern_find() may be called from any thread.
+ * Lookups of existing strings are lock-free; inserting a new string takes a
+ * mutex. intern_str() is a plain array read -- any ID obtained from intern()
+ * (directly, or through data published by another thread) is valid.
+ * Entries are never removed; IDs and canonical pointers stay valid until
+ * intern_fini(). */
+
+typedef uint32_t intern_id_t;
+
+/* Well-known strings, interned in this order on first use so their IDs are
+ * compile-time constants. Keep in sync with WELL_KNOWN[] in intern.c. */
+enum {
+    INTERN_NONE = 0,            /* never a valid string */
+    INTERN_COMPONENT,           /* "Component" -- marks component type entities */
+    INTERN_TAG_SYSTEM,          /* "flecs.system.System" */
+    INTERN_TAG_OBSERVER,        /* "flecs.core.Observer" */
+    /* Builtin pipeline phases, in execution order */
+    INTERN_TAG_PHASE_ONSTART,   /* "flecs.pipeline.OnStart" */
+    INTERN_TAG_PHASE_ONLOAD,
+    INTERN_TAG_PHASE_POSTLOAD,
+    INTERN_TAG_PHASE_PREUPDATE,
+    INTERN_TAG_PHASE_ONUPDATE,
+    INTERN_TAG_PHASE_ONVALIDATE,
+    INTERN_TAG_PHASE_POSTUPDATE,
+    INTERN_TAG_PHASE_PRESTORE,
+    INTERN_TAG_PHASE_ONSTORE,
+    INTERN_TAG_PHASE_POSTFRAME,
+    INTERN_WELL_KNOWN_COUNT
+};
+
+/* Intern a NUL-terminated string / the first len bytes of s.
+ * Returns INTERN_NONE only on allocation failure or NULL input. */
+intern_id_t intern(const char *s);
+intern_id_t intern_n(const char *s, size_t len);
+
+/* ID of s if it was interned before, INTERN_NONE otherwise (never inserts). */
+intern_id_t intern_find(const char *s);
+
+/* Canonical string for id, or NULL for INTERN_NONE / unknown IDs. */
+const char *intern_str(intern_id_t id);
+
+/* Number of distinct strings interned so far (including well-known). */
+uint32_t intern_count(void);
+
+/* Release everything. Call once at shutdown, after all other threads stop. */
+void intern_fini(void);
+
+#endif /* CELS_DEBUG_INTERN_H */
@@ -5,6 +5,37 @@
 #include <string.h>
 #include <yyjson.h>
 
+/* --- Document reading --- */
+
+#define JSON_POOL_MIN (64u * 1024u)
+
+void json_reader_fini(json_reader_t *rd) {
+    free(rd->pool);
+    rd->pool = NULL;
+    rd->pool_size = 0;
+}
+
+// Parse json in place into the reader's pool (or a private copy without one)
+static yyjson_doc *read_doc(json_reader_t *rd, char *json, size_t len) {
+    if (!rd) return yyjson_read(json, len, 0);
+
+    size_t need = yyjson_read_max_memory_usage(len, YYJSON_READ_INSITU);
+    if (need == 0) return NULL;
+    if (need > rd->pool_size) {
+        // Contents are dead between documents -- no need to realloc
+        size_t size = rd->pool_size ? rd->pool_size : JSON_POOL_MIN;
+        while (size < need) size *= 2;
+        free(rd->pool);
+        rd->pool = malloc(size);
+        rd->pool_size = rd->pool ? size : 0;
+        if (!rd->pool) return NULL;
+    }
+
+    // Reset per document: the previous one was freed before its parser returned
+    if (!yyjson_alc_pool_init(&rd->alc, rd->pool, rd->pool_size)) return NULL;
+    return yyjson_read_opts(json, len, YYJSON_READ_INSITU, &rd->alc, NULL);
+}
+
 /* --- World stats parser (existing) --- */
 
 // Extract the latest value from a gauge metric.
@@ -30,10 +61,105 @@ static double extract_latest_gauge(yyjson_val *root, const char *field) {
     return 0.0;
 }
 
-world_snapshot_t *json_parse_world_stats(const char *json, size_t len) {
+// Copy one avg/min/max array into dst, right-aligned so the newest sample
+// is always dst[n - 1]. Slots a short or missing array does not cover take
+// fallback[i] (or 0 without one).
+static void copy_window(yyjson_val *arr, double *dst, int n, const double *fallback) {
+    size_t size = (arr && yyjson_is_arr(arr)) ? yyjson_arr_size(arr) : 0;
+    int count = size < (size_t)n ? (int)size : n;
+    int pad = n - count;
+    size_t skip = size - (size_t)count;
+    for (int i = 0; i < pad; i++) {
+        dst[i] = fallback ? fallback[i] : 0.0;
+    }
+    if (count == 0) return;
+
+    size_t idx, max;
+    yyjson_val *v;
+    yyjson_arr_foreach(arr, idx, max, v) {
+        if (idx < skip) continue;
+        dst[pad + (int)(idx - skip)] = yyjson_is_num(v) ? yyjson_get_num(v) : 0.0;
+    }
+}
+
+static inline yyjson_val *metric_avg(yyjson_val *val) {
+    yyjson_val *avg = yyjson_obj_get(val, "avg");
+    return (avg && yyjson_is_arr(avg) && yyjson_arr_size(avg) > 0) ? avg : NULL;
+}
+
+// Count the metric objects ({"avg": [...], ...}) directly under obj and
+// widen *window to the longest avg array seen.
+static int count_windows(yyjson_val *obj, int *window) {
+    size_t idx, max;
+    yyjson_val *key, *val;
+    int count = 0;
+    yyjson_obj_foreach(obj, idx, max, key, val) {
+        yyjson_val *avg = metric_avg(val);
+        if (!avg) continue;
+        if ((int)yyjson_arr_size(avg) > *window) *window = (int)yyjson_arr_size(avg);
+        count++;
+    }
+    return count;
+}
+
+static bool alloc_windows(metric_window_set_t *set, int count, int window) {
+    if (count == 0) return false;
+    set->metrics = calloc((size_t)count, sizeof(metric_window_t));
+    set->values = malloc((size_t)count * 3 * (size_t)window * sizeof(double));
+    if (!set->metrics || !set->values) {
+        metric_window_set_fini(set);
+        return false;
+    }
+    set->window_len = window;
+    return true;
+}
+
+// Append the metric objects under obj to set (sized by count_windows).
+// With a prefix, names become "<prefix>.<key>".
+static void fill_windows(yyjson_val *obj, const char *prefix, metric_window_set_t *set) {
+    int window = set->window_len;
+    size_t idx, max;
+    yyjson_val *key, *val;
+    yyjson_obj_foreach(obj, idx, max, key, val) {
+        yyjson_val *avg = metric_avg(val);
+        if (!avg) continue;
+
+        metric_window_t *mw = &set->metrics[set->count];
+        double *base = set->values + (size_t)set->count * 3 * (size_t)window;
+        mw->avg = base;
+        mw->min = base + window;
+        mw->max = base + 2 * window;
+
+        const char *k = yyjson_get_str(key);
+        size_t klen = yyjson_get_len(key);
+        if (prefix) {
+            size_t plen = strlen(prefix);
+            char stack[256];
+            char *name = (plen + klen + 2 <= sizeof(stack)) ? stack : malloc(plen + klen + 2);
+            if (!name) continue;
+            memcpy(name, prefix, plen);
+            name[plen] = '.';
+            memcpy(name + plen + 1, k, klen);
+            mw->name = intern_n(name, plen + 1 + klen);
+            if (name != stack) free(name);
+        } else {
+            mw->name = intern_n(k, klen);
+        }
+
+        // Left padding repeats the oldest sample rather than inventing zeros
+        copy_window(avg, mw->avg, window, NULL);
+        int pad = window - (int)yyjson_arr_size(avg);
+        for (int i = 0; i < pad; i++) mw->avg[i] = mw->avg[pad];
+        copy_window(yyjson_obj_get(val, "min"), mw->min, window, mw->avg);
+        copy_window(yyjson_obj_get(val, "max"), mw->max, window, mw->avg);
+        set->count++;
+    }
+}
+
+world_snapshot_t *json_parse_world_stats(json_reader_t *rd, char *json, size_t len) {
     if (!json || len == 0) return NULL;
 
-    yyjson_doc *doc = yyjson_read(json, len, 0);
+    yyjson_doc *doc = read_doc(rd, json, len);
     if (!doc) return NULL;
 
     yyjson_val *root = yyjson_doc_get_root(doc);
@@ -56,6 +182,14 @@ world_snapshot_t *json_parse_world_stats(const char *json, size_t len) {
     double frame_time_s = extract_latest_gauge(root, "performance.frame_time");
     snap->frame_time_ms = frame_time_s * 1000.0;
 
+    // Keep every metric's full sample window too, so the history can be
+    // extended from each poll
+    int window = 0;
+    int count = count_windows(root, &window);
+    if (alloc_windows(&snap->windows, count, window)) {
+        fill_windows(root, NULL, &snap->windows);
+    }
+
     yyjson_doc_free(doc);
     return snap;
 }
@@ -105,31 +239,101 @@ static char *build_full_path(const char *parent_dot, const char *name) {
     return path;
 }
 
-entity_list_t *json_parse_entity_list(const char *json, size_t len) {
-    if (!json || len == 0) return NULL;
+// Join parent (dot-separated) and name into the arena with sep between
+// the path elements: parent dots become sep, then sep and name follow.
+static char *arena_join_path(arena_t *arena, const char *parent_dot,
+                             const char *name, char sep) {
+    if (!name || name[0] == '\0') return NULL;
+    if (!parent_dot || parent_dot[0] == '\0') return arena_strdup(arena, name);
 
-    yyjson_doc *doc = yyjson_read(json, len, 0);
-    if (!doc) return NULL;
+    size_t plen = strlen(parent_dot);
+    size_t nlen = strlen(name);
+    char *path = arena_alloc(arena, plen + 1 + nlen + 1);
+    if (!path) return NULL;
+    for (size_t i = 0; i < plen; i++) {
+        path[i] = parent_dot[i] == '.' ? sep : parent_dot[i];
+    }
+    path[plen] = sep;
+    memcpy(path + plen + 1, name, nlen);
+    path[plen + 1 + nlen] = '\0';
+    return path;
+}
 
-    yyjson_val *root = yyjson_doc_get_root(doc);
-    yyjson_val *results = yyjson_obj_get(root, "results");
-    if (!results || !yyjson_is_arr(results)) {
-        yyjson_doc_free(doc);
-        return NULL;
+// Build full_path from parent (dot-separated) and name directly into the
+// arena: parent dots become slashes, then "/name" is appended.
+static char *arena_full_path(arena_t *arena, const char *parent_dot, const char *name) {
+    return arena_join_path(arena, parent_dot, name, '/');
+}
+
+// Depth from the root, assigned after linking so input order does not matter
+static void assign_depth(entity_node_t *node, int depth) {
+    node->depth = depth;
+    for (int i = 0; i < node->child_count; i++) {
+        assign_depth(node->children[i], depth + 1);
+    }
+}
+
+// True if the /query expression (!ChildOf(flecs), !Module) would not have
+// matched this /world entity: it is a module, or sits below one. modules
+// holds the dotted paths of every module in the dump.
+static bool world_hidden(yyjson_val *entity, const str_map_t *modules) {
+    const char *parent = yyjson_get_str(yyjson_obj_get(entity, "parent"));
+    if (parent && parent[0] != '\0') {
+        for (size_t i = 0;; i++) {
+            if ((parent[i] == '.' || parent[i] == '\0') &&
+                str_map_get(modules, parent, i)) {
+                return true;
+            }
+            if (parent[i] == '\0') break;
+        }
+    } else {
+        const char *name = yyjson_get_str(yyjson_obj_get(entity, "name"));
+        if (name && strcmp(name, "flecs") == 0) return true;
     }
 
+    yyjson_val *tags = yyjson_obj_get(entity, "tags");
+    if (tags && yyjson_is_arr(tags)) {
+        size_t ti, tmax;
+        yyjson_val *tag;
+        yyjson_arr_foreach(tags, ti, tmax, tag) {
+            if (yyjson_equals_str(tag, "flecs.core.Module")) return true;
+        }
+    }
+    return false;
+}
+
+// Dotted path (parent.name) of a /world entity in the arena, NULL if unnamed
+static char *arena_dot_path(arena_t *arena, yyjson_val *entity) {
+    return arena_join_path(arena, yyjson_get_str(yyjson_obj_get(entity, "parent")),
+                           yyjson_get_str(yyjson_obj_get(entity, "name")), '.');
+}
+
+// Build an entity list from a "results" array; the caller keeps the
+// document. hidden (may be NULL) holds the module paths of a /world dump,
+// whose entities the /query expression would have filtered. If want_path
+// is set, *found receives the entity object with that full_path.
+static entity_list_t *build_entity_list(yyjson_val *results, size_t len,
+                                        const str_map_t *hidden,
+                                        const char *want_path, yyjson_val **found) {
     size_t result_count = yyjson_arr_size(results);
     if (result_count == 0) {
-        yyjson_doc_free(doc);
         // Return empty list, not NULL (valid but empty world)
-        entity_list_t *list = entity_list_create();
+        entity_list_t *list = entity_list_create(0);
         return list;
     }
 
-    // Allocate flat node array
-    entity_node_t **nodes = calloc(result_count, sizeof(entity_node_t *));
-    if (!nodes) {
-        yyjson_doc_free(doc);
+    // Everything below lives in the list's arena, sized from the body so
+    // typical generations fit in one or two chunks
+    entity_list_t *list = entity_list_create(len);
+    if (!list) return NULL;
+    arena_t *arena = &list->arena;
+
+    // Flat node array and the lookup indexes (sized up front so the first
+    // pass never rehashes)
+    entity_node_t **nodes = arena_calloc(arena, result_count, sizeof(entity_node_t *));
+    if (!nodes || !str_map_init(&list->by_path, result_count) ||
+        !u64_map_init(&list->by_id, result_count)) {
+        entity_list_free(list);
         return NULL;
     }
 
@@ -143,14 +347,16 @@ entity_list_t *json_parse_entity_list(const char *json, size_t len) {
         yyjson_val *parent_val = yyjson_obj_get(entity, "parent");
         yyjson_val *id_val     = yyjson_obj_get(entity, "id");
 
-        entity_node_t *node = entity_node_create();
+        if (hidden && world_hidden(entity, hidden)) continue;
+
+        entity_node_t *node = entity_list_new_node(list);
         if (!node) continue;
 
         // Name
         if (name_val && yyjson_is_str(name_val)) {
             const char *name_str = yyjson_get_str(name_val);
             if (name_str && name_str[0] != '\0') {
-                node->name = strdup(name_str);
+                node->name = arena_strdup(arena, name_str);
             }
         }
 
@@ -171,15 +377,15 @@ entity_list_t *json_parse_entity_list(const char *json, size_t len) {
         if (node->is_anonymous) {
             // Anonymous: full_path is the string representation of ID
             char id_buf[32];
-            snprintf(id_buf, sizeof(id_buf), "%llu",
-                     (unsigned long long)node->id);
-            node->full_path = strdup(id_buf);
+            int id_len = snprintf(id_buf, sizeof(id_buf), "%llu",
+                                  (unsigned long long)node->id);
+            node->full_path = arena_strndup(arena, id_buf, (size_t)id_len);
         } else {
-            node->full_path = build_full_path(parent_str, node->name);
-            if (!node->full_path) {
-                // Fallback: just the name
-                node->full_path = strdup(node->name);
-            }
+            node->full_path = arena_full_path(arena, parent_str, node->name);
+        }
+        if (want_path && !*found && node->full_path &&
+            strcmp(node->full_path, want_path) == 0) {
+            *found = entity;
         }
 
         // Component names (from "components" object keys)
@@ -187,9 +393,8 @@ entity_list_t *json_parse_entity_list(const char *json, size_t len) {
         if (comps && yyjson_is_obj(comps)) {
             int comp_count = (int)yyjson_obj_size(comps);
             if (comp_count > 0) {
-                node->component_names = calloc((size_t)comp_count, sizeof(char *));
-                if (node->component_names) {
-                    node->component_count = comp_count;
+                node->component_ids = arena_alloc(arena, (size_t)comp_count * sizeof(intern_id_t));
+                if (node->component_ids) {
                     size_t ci, cmax;
                     yyjson_val *ckey, *cval;
                     int c = 0;
@@ -197,7 +402,7 @@ entity_list_t *json_parse_entity_list(const char *json, size_t len) {
                         const char *name = yyjson_get_str(ckey);
                         if (name && strncmp(name, "flecs.doc.", 10) == 0)
                             continue;
-                        node->component_names[c++] = strdup(name);
+                        node->component_ids[c++] = intern_n(name, yyjson_get_len(ckey));
                     }
                     node->component_count = c;
                 }
@@ -209,84 +414,120 @@ entity_list_t *json_parse_entity_list(const char *json, size_t len) {
         if (tags && yyjson_is_arr(tags)) {
             int tag_count = (int)yyjson_arr_size(tags);
             if (tag_count > 0) {
-                node->tags = calloc((size_t)tag_count, sizeof(char *));
-                if (node->tags) {
-                    node->tag_count = tag_count;
+                node->tag_ids = arena_alloc(arena, (size_t)tag_count * sizeof(intern_id_t));
+                if (node->tag_ids) {
                     size_t ti, tmax;
                     yyjson_val *tag;
                     int t = 0;
                     yyjson_arr_foreach(tags, ti, tmax, tag) {
                         if (yyjson_is_str(tag)) {
-                            node->tags[t++] = strdup(yyjson_get_str(tag));
+                            node->tag_ids[t++] = intern_n(yyjson_get_str(tag),
+                                                          yyjson_get_len(tag));
                         }
                     }
                     node->tag_count = t;  // actual count (may differ if non-string tags)
                 }
             }
         }
+        entity_list_index_tags(list, node);
+
+        // Index by path and id (first occurrence wins on duplicates)
+        if (node->full_path) {
+            size_t path_len = strlen(node->full_path);
+            if (!str_map_get(&list->by_path, node->full_path, path_len)) {
+                str_map_put(&list->by_path, node->full_path, path_len, node);
+            }
+        }
+        if (!u64_map_get(&list->by_id, node->id)) {
+            u64_map_put(&list->by_id, node->id, node);
+        }
 
         nodes[node_count++] = node;
     }
 
-    // Second pass: build parent-child tree.
-    // For each node that has a parent, look up the parent's full_path in nodes[].
-    // O(n^2) linear scan -- acceptable for <5K entities.
+    // Second pass: resolve parents and count children.
+    // The parent's full_path is this node's path up to the last '/', looked
+    // up in the path index -- linear in the number of entities.
+    int root_count = 0;
     for (int i = 0; i < node_count; i++) {
         entity_node_t *node = nodes[i];
-        if (!node->full_path) continue;
-
-        // Find the last '/' in full_path to get parent's path
-        const char *last_slash = strrchr(node->full_path, '/');
-        if (!last_slash) continue;  // root node, no parent
-
-        size_t parent_len = (size_t)(last_slash - node->full_path);
-        if (parent_len == 0) continue;
-
-        // Search for a node with matching full_path
-        for (int j = 0; j < node_count; j++) {
-            if (i == j) continue;
-            entity_node_t *candidate = nodes[j];
-            if (!candidate->full_path) continue;
-            if (strlen(candidate->full_path) == parent_len &&
-                strncmp(candidate->full_path, node->full_path, parent_len) == 0) {
-                entity_node_add_child(candidate, node);
-                break;
-            }
+        const char *last_slash = node->full_path ? strrchr(node->full_path, '/') : NULL;
+        entity_node_t *parent = NULL;
+        if (last_slash && last_slash != node->full_path) {
+            size_t parent_len = (size_t)(last_slash - node->full_path);
+            parent = str_map_get(&list->by_path, node->full_path, parent_len);
+        }
+        if (parent && parent != node) {
+            node->parent = parent;
+            parent->child_count++;
+        } else {
+            root_count++;
         }
     }
 
-    // Collect roots (nodes with no parent)
-    int root_cap = 16;
-    entity_node_t **roots = calloc((size_t)root_cap, sizeof(entity_node_t *));
-    int root_count = 0;
+    // Third pass: exact-size children arrays, then fill them in input order
     for (int i = 0; i < node_count; i++) {
-        if (nodes[i]->parent == NULL) {
-            if (root_count >= root_cap) {
-                root_cap *= 2;
-                roots = realloc(roots, (size_t)root_cap * sizeof(entity_node_t *));
+        entity_node_t *node = nodes[i];
+        if (node->child_count > 0) {
+            node->children = arena_alloc(arena,
+                (size_t)node->child_count * sizeof(entity_node_t *));
+            if (!node->children) {
+                entity_list_free(list);
+                return NULL;
             }
-            roots[root_count++] = nodes[i];
+            node->child_count = 0;
         }
     }
-
-    // Build result
-    entity_list_t *list = entity_list_create();
-    if (!list) {
-        for (int i = 0; i < node_count; i++) {
-            entity_node_free(nodes[i]);
-        }
-        free(nodes);
-        free(roots);
-        yyjson_doc_free(doc);
+    entity_node_t **roots = arena_alloc(arena,
+        (size_t)(root_count > 0 ? root_count : 1) * sizeof(entity_node_t *));
+    if (!roots) {
+        entity_list_free(list);
         return NULL;
     }
+    root_count = 0;
+    for (int i = 0; i < node_count; i++) {
+        entity_node_t *node = nodes[i];
+        if (node->parent) {
+            node->parent->children[node->parent->child_count++] = node;
+        } else {
+            roots[root_count++] = node;
+        }
+    }
+    for (int i = 0; i < root_count; i++) {
+        assign_depth(roots[i], 0);
+    }
+
+    // Signatures let the UI reuse unchanged nodes' derived state
+    for (int i = 0; i < node_count; i++) {
+        nodes[i]->signature = entity_node_signature(nodes[i]);
+    }
 
     list->nodes = nodes;
     list->count = node_count;
     list->roots = roots;
     list->root_count = root_count;
 
-    yyjson_doc_free(doc);  // Safe: all strings were strdup'd
+    // Built here, off the UI thread; an empty index only costs the inspector
+    // its "Entities with X" list, no archetypes only the Archetypes tab
+    entity_list_build_component_index(list);
+    entity_list_build_archetypes(list);
+    return list;
+}
+
+entity_list_t *json_parse_entity_list(json_reader_t *rd, char *json, size_t len) {
+    if (!json || len == 0) return NULL;
+
+    yyjson_doc *doc = read_doc(rd, json, len);
+    if (!doc) return NULL;
+
+    yyjson_val *root = yyjson_doc_get_root(doc);
+    yyjson_val *results = yyjson_obj_get(root, "results");
+    entity_list_t *list = NULL;
+    if (results && yyjson_is_arr(results)) {
+        list = build_entity_list(results, len, NULL, NULL, NULL);
+    }
+
+    yyjson_doc_free(doc);  // Safe: all strings were copied into the arena
     return list;
 }
 
@@ -369,10 +610,73 @@ static double extract_pipeline_gauge(yyjson_val *obj, const char *field) {
     return (last && yyjson_is_num(last)) ? yyjson_get_num(last) : 0.0;
 }
 
-system_registry_t *json_parse_pipeline_stats(const char *json, size_t len) {
+// Window of set[first..count) whose name is "<prefix>.<field>"
+static const metric_window_t *find_window(const metric_window_set_t *set, int first,
+                                          size_t prefix_len, const char *field) {
+    for (int i = first; i < set->count; i++) {
+        const char *name = intern_str(set->metrics[i].name);
+        if (name && strlen(name) > prefix_len && strcmp(name + prefix_len + 1, field) == 0) {
+            return &set->metrics[i];
+        }
+    }
+    return NULL;
+}
+
+// Window-wide average and worst case of a time_spent window, in ms.
+// Without a window both are the latest value.
+static void time_window_summary(const metric_window_t *tw, int len, double latest_ms,
+                                double *avg_ms, double *worst_ms) {
+    if (!tw || len == 0) {
+        *avg_ms = *worst_ms = latest_ms;
+        return;
+    }
+    double sum = 0.0, worst = 0.0;
+    for (int i = 0; i < len; i++) {
+        sum += tw->avg[i];
+        if (tw->max[i] > worst) worst = tw->max[i];
+    }
+    *avg_ms = sum / len * 1000.0;
+    *worst_ms = worst * 1000.0;
+}
+
+// Derive a system's window-wide average and worst case from its time_spent
+// window (filled from index first on)
+static void attach_system_windows(system_info_t *si, const metric_window_set_t *set,
+                                  int first, size_t prefix_len) {
+    const metric_window_t *tw = find_window(set, first, prefix_len, "time_spent");
+    time_window_summary(tw, set->window_len, si->time_spent_ms,
+                        &si->time_avg_ms, &si->time_worst_ms);
+}
+
+// Close the current segment with the sync point entry that ends it
+static void parse_sync_point(yyjson_val *entry, pipeline_segment_t *seg, int sync_idx,
+                             metric_window_set_t *set) {
+    yyjson_val *count_val = yyjson_obj_get(entry, "system_count");
+    seg->reported_count = yyjson_is_num(count_val) ? (int)yyjson_get_num(count_val) : 0;
+    seg->has_sync = true;
+    yyjson_val *mt = yyjson_obj_get(entry, "multi_threaded");
+    seg->multi_threaded = mt && yyjson_is_bool(mt) && yyjson_get_bool(mt);
+    yyjson_val *imm = yyjson_obj_get(entry, "immediate");
+    seg->immediate = imm && yyjson_is_bool(imm) && yyjson_get_bool(imm);
+    seg->sync_ms = extract_pipeline_gauge(entry, "time_spent") * 1000.0;
+    seg->commands_enqueued = extract_pipeline_gauge(entry, "commands_enqueued");
+
+    const metric_window_t *tw = NULL;
+    if (set->metrics) {
+        char prefix[32];
+        snprintf(prefix, sizeof(prefix), "sync.%d", sync_idx);
+        int first = set->count;
+        fill_windows(entry, prefix, set);
+        tw = find_window(set, first, strlen(prefix), "time_spent");
+    }
+    time_window_summary(tw, set->window_len, seg->sync_ms,
+                        &seg->sync_avg_ms, &seg->sync_worst_ms);
+}
+
+system_registry_t *json_parse_pipeline_stats(json_reader_t *rd, char *json, size_t len) {
     if (!json || len == 0) return NULL;
 
-    yyjson_doc *doc = yyjson_read(json, len, 0);
+    yyjson_doc *doc = read_doc(rd, json, len);
     if (!doc) return NULL;
 
     yyjson_val *root = yyjson_doc_get_root(doc);
@@ -381,14 +685,22 @@ system_registry_t *json_parse_pipeline_stats(const char *json, size_t len) {
         return NULL;
     }
 
-    // First pass: count system entries (those with "name", NOT "system_count")
+    // First pass: count system entries (those with "name") and sync points
+    // (those with "system_count")
     size_t idx, max;
     yyjson_val *entry;
     int sys_count = 0;
+    int sync_count = 0;
+    int win_count = 0;
+    int window = 0;
 
     yyjson_arr_foreach(root, idx, max, entry) {
-        if (yyjson_obj_get(entry, "name") && !yyjson_obj_get(entry, "system_count")) {
+        if (yyjson_obj_get(entry, "system_count")) {
+            sync_count++;
+            win_count += count_windows(entry, &window);
+        } else if (yyjson_obj_get(entry, "name")) {
             sys_count++;
+            win_count += count_windows(entry, &window);
         }
     }
 
@@ -404,20 +716,32 @@ system_registry_t *json_parse_pipeline_stats(const char *json, size_t len) {
     }
 
     reg->systems = calloc((size_t)sys_count, sizeof(system_info_t));
-    if (!reg->systems) {
+    // One segment per sync point, plus the systems after the last one
+    reg->segments = calloc((size_t)sync_count + 1, sizeof(pipeline_segment_t));
+    if (!reg->systems || !reg->segments) {
         yyjson_doc_free(doc);
+        free(reg->systems);
+        free(reg->segments);
         free(reg);
         return NULL;
     }
 
-    // Second pass: extract system info
+    alloc_windows(&reg->windows, win_count, window);
+
+    // Second pass: extract system info, cutting segments at sync points
     int si = 0;
+    pipeline_segment_t *seg = &reg->segments[0];
     yyjson_arr_foreach(root, idx, max, entry) {
-        yyjson_val *name_val = yyjson_obj_get(entry, "name");
-        if (!name_val || yyjson_obj_get(entry, "system_count")) {
-            continue;  // skip sync points
+        if (yyjson_obj_get(entry, "system_count")) {
+            parse_sync_point(entry, seg, reg->segment_count, &reg->windows);
+            seg->first_system = si - seg->system_count;
+            seg = &reg->segments[++reg->segment_count];
+            continue;
         }
 
+        yyjson_val *name_val = yyjson_obj_get(entry, "name");
+        if (!name_val) continue;
+
         const char *name_str = yyjson_get_str(name_val);
         if (!name_str) continue;
 
@@ -442,12 +766,31 @@ system_registry_t *json_parse_pipeline_stats(const char *json, size_t len) {
         reg->systems[si].time_spent_ms =
             extract_pipeline_gauge(entry, "time_spent") * 1000.0;
 
-        // phase: NULL here -- filled by tab_ecs enrichment in Plan 02
+        // phase: NULL here -- assigned by analysis_update() from the
+        // system's entity tags
         reg->systems[si].phase = NULL;
 
+        if (reg->windows.metrics) {
+            int first = reg->windows.count;
+            fill_windows(entry, name_str, &reg->windows);
+            attach_system_windows(&reg->systems[si], &reg->windows, first,
+                                  strlen(name_str));
+        } else {
+            reg->systems[si].time_avg_ms = reg->systems[si].time_spent_ms;
+            reg->systems[si].time_worst_ms = reg->systems[si].time_spent_ms;
+        }
+
+        seg->system_count++;
+        seg->systems_ms += reg->systems[si].time_spent_ms;
         si++;
     }
 
+    // Trailing systems that no sync point closed
+    if (seg->system_count > 0) {
+        seg->first_system = si - seg->system_count;
+        reg->segment_count++;
+    }
+
     reg->count = si;
     yyjson_doc_free(doc);
     return reg;
@@ -625,10 +968,10 @@ bool json_parse_bench_baseline(const char *json, size_t len,
 
 /* --- Component registry parser --- */
 
-component_registry_t *json_parse_component_registry(const char *json, size_t len) {
+component_registry_t *json_parse_component_registry(json_reader_t *rd, char *json, size_t len) {
     if (!json || len == 0) return NULL;
 
-    yyjson_doc *doc = yyjson_read(json, len, 0);
+    yyjson_doc *doc = read_doc(rd, json, len);
     if (!doc) return NULL;
 
     yyjson_val *root = yyjson_doc_get_root(doc);
@@ -687,3 +1030,134 @@ component_registry_t *json_parse_component_registry(const char *json, size_t len
     yyjson_doc_free(doc);  // Safe: all strings were strdup'd
     return reg;
 }
+
+/* --- World dump parser --- */
+
+// Components of a /world dump: every entity carrying the "Component"
+// component, sized from its value, counted over all entities in the dump
+static component_registry_t *world_component_registry(yyjson_val *results,
+                                                      arena_t *arena) {
+    component_registry_t *reg = component_registry_create();
+    if (!reg) return NULL;
+
+    u64_map_t slot_of = {0};  // component intern id -> index + 1
+    size_t count = 0;
+    size_t idx, max;
+    yyjson_val *entity;
+    yyjson_arr_foreach(results, idx, max, entity) {
+        yyjson_val *comps = yyjson_obj_get(entity, "components");
+        if (comps && yyjson_is_obj(comps) && yyjson_obj_get(comps, "Component")) count++;
+    }
+    if (count == 0) return reg;
+
+    reg->components = calloc(count, sizeof(component_info_t));
+    if (!reg->components || !u64_map_init(&slot_of, count)) {
+        component_registry_free(reg);
+        return NULL;
+    }
+
+    int ci = 0;
+    yyjson_arr_foreach(results, idx, max, entity) {
+        yyjson_val *comps = yyjson_obj_get(entity, "components");
+        yyjson_val *type_val = comps && yyjson_is_obj(comps)
+            ? yyjson_obj_get(comps, "Component") : NULL;
+        if (!type_val || ci == (int)count) continue;
+
+        char *name = arena_dot_path(arena, entity);
+        intern_id_t id = name ? intern(name) : INTERN_NONE;
+        if (id == INTERN_NONE || u64_map_get(&slot_of, id)) continue;
+
+        component_info_t *info = &reg->components[ci];
+        info->name = strdup(name);
+        if (!info->name) continue;
+        if (yyjson_is_obj(type_val)) {
+            info->has_type_info = true;
+            yyjson_val *sz = yyjson_obj_get(type_val, "size");
+            if (sz && yyjson_is_num(sz)) info->size = (int)yyjson_get_int(sz);
+        }
+        u64_map_put(&slot_of, id, (void *)(uintptr_t)(ci + 1));
+        ci++;
+    }
+    reg->count = ci;
+
+    // Entity counts: one pass over every entity's component keys
+    yyjson_arr_foreach(results, idx, max, entity) {
+        yyjson_val *comps = yyjson_obj_get(entity, "components");
+        if (!comps || !yyjson_is_obj(comps)) continue;
+        size_t ki, kmax;
+        yyjson_val *key, *val;
+        yyjson_obj_foreach(comps, ki, kmax, key, val) {
+            intern_id_t id = intern_n(yyjson_get_str(key), yyjson_get_len(key));
+            uintptr_t slot = (uintptr_t)u64_map_get(&slot_of, id);
+            if (slot != 0) reg->components[slot - 1].entity_count++;
+        }
+    }
+
+    u64_map_fini(&slot_of);
+    return reg;
+}
+
+entity_list_t *json_parse_world(json_reader_t *rd, char *json, size_t len,
+                                const char *detail_path,
+                                component_registry_t **registry,
+                                entity_detail_t **detail) {
+    *registry = NULL;
+    *detail = NULL;
+    if (!json || len == 0) return NULL;
+
+    yyjson_doc *doc = read_doc(rd, json, len);
+    if (!doc) return NULL;
+
+    yyjson_val *root = yyjson_doc_get_root(doc);
+    yyjson_val *results = yyjson_obj_get(root, "results");
+    if (!results || !yyjson_is_arr(results)) {
+        yyjson_doc_free(doc);
+        return NULL;
+    }
+
+    // Module paths (for the /query filter) and component names are only
+    // needed during the parse
+    arena_t scratch;
+    arena_init(&scratch, 4096);
+    str_map_t modules = {0};
+    char flecs_root[] = "flecs";
+    bool ok = str_map_put(&modules, flecs_root, sizeof(flecs_root) - 1, flecs_root);
+
+    size_t idx, max;
+    yyjson_val *entity;
+    yyjson_arr_foreach(results, idx, max, entity) {
+        yyjson_val *tags = yyjson_obj_get(entity, "tags");
+        if (!ok || !tags || !yyjson_is_arr(tags)) continue;
+        size_t ti, tmax;
+        yyjson_val *tag;
+        yyjson_arr_foreach(tags, ti, tmax, tag) {
+            if (!yyjson_equals_str(tag, "flecs.core.Module")) continue;
+            char *path = arena_dot_path(&scratch, entity);
+            if (path) ok = str_map_put(&modules, path, strlen(path), path);
+            break;
+        }
+    }
+
+    yyjson_val *found = NULL;
+    entity_list_t *list = ok
+        ? build_entity_list(results, len, &modules, detail_path, &found) : NULL;
+    component_registry_t *reg = list ? world_component_registry(results, &scratch) : NULL;
+    if (list && !reg) {
+        entity_list_free(list);
+        list = NULL;
+    }
+
+    // The detail owns its document, so the entity is parsed from a copy
+    if (list && found) {
+        size_t detail_len = 0;
+        char *copy = yyjson_val_write(found, 0, &detail_len);
+        if (copy) *detail = json_parse_entity_detail(copy, detail_len);
+        free(copy);
+    }
+
+    str_map_fini(&modules);
+    arena_free(&scratch);
+    yyjson_doc_free(doc);
+    *registry = reg;
+    return list;
+}
@@ -4,20 +4,41 @@
 #include "data_model.h"
 #include <stddef.h>
 
+// Zero bytes the in-situ parsers need after the input
+#define JSON_INSITU_PADDING YYJSON_PADDING_SIZE
+
+// Reusable parse state for one endpoint. With a reader, the parsers below
+// read the input IN PLACE: it is modified, and must be followed by
+// JSON_INSITU_PADDING zero bytes. The DOM comes from a pool allocator whose
+// buffer is kept and grown geometrically across calls. Once the pool fits
+// the largest response, parsing that endpoint allocates nothing for the DOM.
+// The pool is sized by yyjson_read_max_memory_usage(), a worst-case bound.
+// Every parser frees its document before returning, so one pool serves all
+// calls. Pass NULL instead to parse a private copy of const input.
+typedef struct json_reader {
+    void *pool;             // pool allocator backing memory
+    size_t pool_size;
+    yyjson_alc alc;
+} json_reader_t;
+
+// Release the reader's pool. The reader can be reused afterwards.
+void json_reader_fini(json_reader_t *rd);
+
 // Parse /stats/world JSON response into a world_snapshot_t.
 // Returns a newly allocated snapshot on success, NULL on parse failure.
 // Caller owns the returned snapshot and must call world_snapshot_free().
 //
 // The /stats/world response has metrics like:
 //   "entities.count": { "avg": [60 floats], "min": [...], "max": [...] }
-// We extract the LAST element of "avg" (most recent measurement).
-world_snapshot_t *json_parse_world_stats(const char *json, size_t len);
+// We extract the LAST element of "avg" (most recent measurement) for the
+// headline fields, and keep every metric's full window in snap->windows.
+world_snapshot_t *json_parse_world_stats(json_reader_t *rd, char *json, size_t len);
 
 // Parse /query response into an entity_list_t with parent-child tree.
 // The query uses table=true, values=false, entity_id=true.
 // Returns a newly allocated list on success, NULL on parse failure.
 // Caller owns the returned list and must call entity_list_free().
-entity_list_t *json_parse_entity_list(const char *json, size_t len);
+entity_list_t *json_parse_entity_list(json_reader_t *rd, char *json, size_t len);
 
 // Parse /entity/<path> response into an entity_detail_t.
 // The entity_detail_t OWNS the yyjson_doc -- caller frees via entity_detail_free().
@@ -28,14 +49,36 @@ entity_detail_t *json_parse_entity_detail(const char *json, size_t len);
 // The response root is a JSON array (not object).
 // Returns a newly allocated registry on success, NULL on parse failure.
 // Caller owns the returned registry and must call component_registry_free().
-component_registry_t *json_parse_component_registry(const char *json, size_t len);
+component_registry_t *json_parse_component_registry(json_reader_t *rd, char *json, size_t len);
+
+// Parse a /world dump into the datasets /query, /components and /entity
+// would have returned, from one document:
+//   - the entity list, without the flecs and module entities the /query
+//     expression filters out
+//   - *registry: every entity with the "Component" component, named by
+//     its dotted path, sized from the component value and counted over
+//     all entities in the dump
+//   - *detail: the entity at detail_path (slash-separated), or NULL if
+//     detail_path is NULL, not in the dump, or one of the entities
+//     filtered out above (those never resolve here). Built from the dump's
+//     values, so it has no doc brief unless the dump carries "doc".
+// Returns NULL (with *registry and *detail NULL) on parse failure.
+// Caller owns every returned dataset.
+entity_list_t *json_parse_world(json_reader_t *rd, char *json, size_t len,
+                                const char *detail_path,
+                                component_registry_t **registry,
+                                entity_detail_t **detail);
 
 // Parse /stats/pipeline JSON response into a system_registry_t.
 // The response is a JSON array alternating system entries (have "name") and
-// sync point entries (have "system_count"). Only system entries are parsed.
+// sync point entries (have "system_count"). System entries become
+// reg->systems, with each system's metric windows kept as
+// "<full_path>.<metric>". Each sync point closes a pipeline segment (the
+// systems before it plus the merge) in reg->segments, and its windows are
+// kept as "sync.<n>.<metric>".
 // Returns a newly allocated registry on success, NULL on parse failure.
 // Caller owns the returned registry and must call system_registry_free().
-system_registry_t *json_parse_pipeline_stats(const char *json, size_t len);
+system_registry_t *json_parse_pipeline_stats(json_reader_t *rd, char *json, size_t len);
 
 // Parse test report JSON (tests/output/latest.json) into a test_report_t.
 // Expects: { "version", "timestamp", "summary", "tests": [...], "benchmarks": [...] }
@@ -1,23 +1,53 @@
 /*
  * cels-debug -- Terminal-based ECS inspector for CELS applications
- * Main event loop: input -> poll -> render
+ * Main event loop: input -> install latest poll generation -> render -> wait
+ * (REST polling runs on the background poller thread, see poller.c)
+ *
+ * The loop sleeps in poll() on stdin and the poller's notify fd, so it only
+ * wakes for a keystroke, a finished poll generation, SIGWINCH or a timed
+ * footer expiry -- idle CPU is near zero and keys are handled immediately.
+ * A frame is only rendered when one of those actually changed something,
+ * and only tabs whose datasets changed are redrawn (see tab_t.dirty).
  */
 #define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <poll.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
 #include <ncurses.h>
 
 #include "http_client.h"
-#include "json_parser.h"
 #include "data_model.h"
+#include "analysis.h"
+#include "intern.h"
+#include "poller.h"
 #include "tab_system.h"
 #include "tui.h"
+#include "world_bench.h"
 
 #define POLL_INTERVAL_MS 500
 
+/* Metric history caps. A world series costs a fixed ~120 KB (see
+ * metric_history.h). The pipeline history keeps one series per system
+ * (see pipeline_history_keep) without the rollups nothing reads, ~44 KB
+ * each; systems past the cap are counted as dropped on Overview. */
+#define WORLD_HISTORY_MAX_SERIES    256
+#define PIPELINE_HISTORY_MAX_SERIES 256
+
+/* Performance reads a system's last raw minute and a few seconds of
+ * per-second means; nothing reads its minute tier */
+static const int PIPELINE_HISTORY_TIERS[METRIC_TIER_COUNT] = {
+    [METRIC_TIER_SECOND] = 60,
+    [METRIC_TIER_MINUTE] = 0,
+};
+
+/* Datasets one /world dump replaces in bulk mode (-w) */
+#define WORLD_DUMP_ENDPOINTS (ENDPOINT_QUERY | ENDPOINT_ENTITY | ENDPOINT_COMPONENTS)
+
 static volatile int g_running = 1;
 
 /* Navigation back-stack helpers */
@@ -46,11 +76,203 @@ static int64_t now_ms(void) {
     return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
 }
 
+/* Dispatch one key -- global keys first, then tab switching, then per-tab.
+ * Returns false when the user asked to quit. */
+static bool handle_key(int ch, tab_system_t *tabs, app_state_t *state) {
+    if (ch == 'q' || ch == 'Q') {
+        return false;
+    }
+
+    if (ch == KEY_RESIZE) {
+        tui_resize();
+        tab_system_mark_all_dirty(tabs);
+    }
+
+    /* Esc key: pop nav stack or pass to active tab */
+    if (ch == 27) {
+        nav_entry_t entry;
+        if (nav_pop(&state->nav_stack, &entry)) {
+            tab_system_activate(tabs, entry.tab_index);
+            /* Restore entity selection if possible */
+            if (entry.entity_id != 0) {
+                entity_node_t *n = entity_list_find_by_id(state->entity_list,
+                                                          entry.entity_id);
+                if (n && n->full_path) {
+                    free(state->selected_entity_path);
+                    state->selected_entity_path = strdup(n->full_path);
+                }
+            }
+        } else {
+            /* No nav history -- pass to tab */
+            tab_system_handle_input(tabs, ch, state);
+        }
+    } else if (ch >= '1' && ch <= '0' + TAB_COUNT) {
+        /* Direct tab switch -- clear nav stack (new context) */
+        nav_clear(&state->nav_stack);
+        tab_system_activate(tabs, ch - '1');
+    } else if (ch == '\t') {
+        /* Tab key -- clear nav stack (new context) */
+        nav_clear(&state->nav_stack);
+        tab_system_next(tabs);
+    } else {
+        tab_system_handle_input(tabs, ch, state);
+    }
+
+    /* Cross-tab navigation (e.g., Systems tab -> CELS tab) */
+    if (state->pending_tab >= 0) {
+        /* Push current tab onto nav stack before switching */
+        nav_push(&state->nav_stack, tabs->active, 0);
+        tab_system_activate(tabs, state->pending_tab);
+        state->pending_tab = -1;
+    }
+    return true;
+}
+
+/* Feed the frame-time samples the last world ingest appended into the
+ * quantile tracker and check each against the spike trigger. Samples are
+ * placed in time by their history seq. The worst sample over the threshold
+ * captures the current datasets, so each poll logs at most one spike. */
+static void track_frame_times(app_state_t *state, int fresh, int64_t now) {
+    if (fresh <= 0 || !state->frame_quantiles) return;
+    const metric_history_t *h = &state->world_history;
+    const metric_series_t *s = metric_history_find(h, "performance.frame_time");
+    if (!s) return;
+
+    /* Median of the minute before these samples, so a spike cannot
+     * raise its own bar */
+    quantile_summary_t q = quantile_tracker_summary(state->frame_quantiles,
+                                                    QUANTILE_WINDOW_1MIN);
+    double median = q.count >= SPIKE_MEDIAN_MIN_SAMPLES ? q.p50 : 0.0;
+    double threshold = spike_trigger_threshold(&state->spikes.trigger, median);
+
+    metric_sample_t samples[METRIC_HISTORY_CAPACITY];
+    int n = metric_history_recent(h, s, samples, fresh);
+    int worst = -1;
+    for (int i = 0; i < n; i++) {
+        uint64_t seq = h->seq - (uint64_t)n + (uint64_t)i;
+        double ms = samples[i].avg * 1000.0;  /* seconds -> ms */
+        quantile_tracker_add(state->frame_quantiles, seq / METRIC_SAMPLE_HZ, ms);
+        if (threshold > 0.0 && ms > threshold &&
+            (worst < 0 || ms > samples[worst].avg * 1000.0)) {
+            worst = i;
+        }
+    }
+    if (worst >= 0) {
+        spike_log_capture(&state->spikes, h->seq - (uint64_t)n + (uint64_t)worst,
+                          now, samples[worst].avg * 1000.0, threshold, median,
+                          state->snapshot, state->system_registry);
+    }
+}
+
+/* The Performance tab only charts each system's time_spent; sync point
+ * windows and the matched counts are not worth a series */
+static bool pipeline_history_keep(const char *name) {
+    static const char suffix[] = ".time_spent";
+    size_t len = name ? strlen(name) : 0;
+    return len > sizeof(suffix) - 1 &&
+           strcmp(name + len - (sizeof(suffix) - 1), suffix) == 0 &&
+           strncmp(name, "sync.", 5) != 0;
+}
+
+/* Install a finished poll generation into app_state. Datasets the result
+ * carries replace the current ones (bumping their generation); everything
+ * else is left untouched. Returns the ENDPOINT_* mask of replaced datasets. */
+static uint32_t apply_poll_result(app_state_t *state, poll_result_t *r, int64_t now) {
+    uint32_t changed = ENDPOINT_NONE;
+    int fresh_frames = 0;
+    state->conn_state = r->conn_state;
+
+    if (memcmp(state->poll_stats, r->stats, sizeof(r->stats)) != 0) {
+        memcpy(state->poll_stats, r->stats, sizeof(r->stats));
+        changed |= ENDPOINT_POLL_STATS;
+    }
+
+    if (r->snapshot) {
+        world_snapshot_free(state->snapshot);
+        state->snapshot = r->snapshot;
+        r->snapshot = NULL;
+        state->snapshot_gen++;
+        fresh_frames = metric_history_ingest(&state->world_history,
+                                             &state->snapshot->windows, now);
+        changed |= ENDPOINT_STATS_WORLD;
+    }
+    /* An identical entity list keeps the installed generation, so nothing
+     * derived from it (classification, tree rows) is recomputed */
+    if (r->entity_list && entity_list_reconcile(r->entity_list, state->entity_list)) {
+        entity_list_free(state->entity_list);
+        state->entity_list = r->entity_list;
+        r->entity_list = NULL;
+        state->entity_list_gen++;
+        changed |= ENDPOINT_QUERY;
+    }
+    if (r->component_registry) {
+        component_registry_free(state->component_registry);
+        state->component_registry = r->component_registry;
+        r->component_registry = NULL;
+        state->component_registry_gen++;
+        footprint_tracker_ingest(&state->footprints, state->component_registry, now);
+        changed |= ENDPOINT_COMPONENTS;
+    }
+    if (r->system_registry) {
+        system_registry_free(state->system_registry);
+        state->system_registry = r->system_registry;
+        r->system_registry = NULL;
+        state->system_registry_gen++;
+        metric_history_ingest(&state->pipeline_history, &state->system_registry->windows, now);
+        changed |= ENDPOINT_STATS_PIPELINE;
+    }
+
+    /* Entity detail only applies if the selection has not moved on since
+     * the request was issued */
+    if (r->detail_path && state->selected_entity_path &&
+        strcmp(r->detail_path, state->selected_entity_path) == 0) {
+        if (r->entity_detail) {
+            entity_detail_free(state->entity_detail);
+            state->entity_detail = r->entity_detail;
+            r->entity_detail = NULL;
+            state->entity_detail_gen++;
+            changed |= ENDPOINT_ENTITY;
+        } else if (r->detail_removed) {
+            /* Entity was deleted -- clear detail and notify */
+            entity_detail_free(state->entity_detail);
+            state->entity_detail = NULL;
+            state->entity_detail_gen++;
+            changed |= ENDPOINT_ENTITY;
+            free(state->footer_message);
+            state->footer_message = strdup("Selected entity removed");
+            state->footer_message_expire = now + 3000; /* 3 seconds */
+            free(state->selected_entity_path);
+            state->selected_entity_path = NULL;
+        }
+    }
+
+    if (changed & (ENDPOINT_QUERY | ENDPOINT_STATS_PIPELINE)) {
+        system_index_rebuild(&state->system_index, state->entity_list,
+                             state->system_registry);
+    }
+    /* Classification and enrichment, once per generation for every tab */
+    analysis_update(state->entity_list, state->component_registry,
+                    state->system_registry, &state->system_index, changed);
+
+    /* After every dataset is in, so a spike freezes this generation */
+    track_frame_times(state, fresh_frames, now);
+    return changed;
+}
+
 int main(int argc, char *argv[]) {
     /* Parse command-line flags */
     int poll_interval = POLL_INTERVAL_MS;
     const char *test_json_path = CELS_TEST_OUTPUT_DIR "/latest.json";
     const char *baseline_json_path = NULL;
+    /* Off unless -s arms it: an armed trigger polls /stats/pipeline and
+     * copies the raw bodies on every cycle, whatever tab is shown */
+    spike_trigger_t spike_trigger = { SPIKE_MODE_OFF, 0.0 };
+    intern_id_t dashboard[METRIC_DASHBOARD_MAX];
+    int dashboard_count = metric_dashboard_parse(METRIC_DASHBOARD_DEFAULT, dashboard,
+                                                 METRIC_DASHBOARD_MAX);
+    bool bulk = false;
+    bool track_footprints = false;
+    int bench_rounds = 0;
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
             poll_interval = atoi(argv[++i]);
@@ -60,23 +282,47 @@ int main(int argc, char *argv[]) {
             test_json_path = argv[++i];
         } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
             baseline_json_path = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            /* Spike trigger: "off", "<ms>ms" or "<n>x" the rolling median */
+            if (!spike_trigger_parse(argv[++i], &spike_trigger)) {
+                fprintf(stderr, "Invalid spike trigger '%s' (use off, 33ms or 3x)\n",
+                        argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            /* Overview dashboard: comma-separated /stats/world metrics */
+            dashboard_count = metric_dashboard_parse(argv[++i], dashboard,
+                                                     METRIC_DASHBOARD_MAX);
+            if (dashboard_count < 0) {
+                fprintf(stderr, "Invalid metric list '%s' (use e.g. tables.count,memory.alloc_count)\n",
+                        argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-w") == 0) {
+            /* Bulk mode: one /world request instead of /query, /entity
+             * and /components */
+            bulk = true;
+        } else if (strcmp(argv[i], "-f") == 0) {
+            /* Footprint trends for the whole session, not just while a
+             * tab that shows components is open */
+            track_footprints = true;
+        } else if (strcmp(argv[i], "-B") == 0 && i + 1 < argc) {
+            /* Benchmark per-endpoint vs bulk fetching, then exit */
+            bench_rounds = atoi(argv[++i]);
+            if (bench_rounds < 1) bench_rounds = 1;
         }
     }
 
-    const char *url = "http://localhost:27750/stats/world";
+    if (bench_rounds > 0) {
+        bool ok = world_bench_run(bench_rounds, stdout);
+        intern_fini();
+        return ok ? 0 : 1;
+    }
 
     /* Initialize TUI first (registers signal handlers) */
     tui_init();
 
-    /* Initialize HTTP client */
-    CURL *curl = http_client_init();
-    if (!curl) {
-        tui_fini();
-        fprintf(stderr, "ERROR: Failed to initialize HTTP client\n");
-        return 1;
-    }
-
-    /* Initialize tab system (after tui_init and http_client_init) */
+    /* Initialize tab system (after tui_init) */
     tab_system_t tabs;
     tab_system_init(&tabs);
 
@@ -85,6 +331,13 @@ int main(int argc, char *argv[]) {
     app_state.pending_tab = -1;
     app_state.nav_stack.top = -1;
     app_state.poll_interval_ms = poll_interval;
+    metric_history_init(&app_state.world_history, WORLD_HISTORY_MAX_SERIES, NULL, NULL);
+    metric_history_init(&app_state.pipeline_history, PIPELINE_HISTORY_MAX_SERIES,
+                        pipeline_history_keep, PIPELINE_HISTORY_TIERS);
+    app_state.frame_quantiles = quantile_tracker_create();
+    app_state.spikes.trigger = spike_trigger;
+    memcpy(app_state.dashboard, dashboard, sizeof(dashboard));
+    app_state.dashboard_count = dashboard_count;
     if (test_json_path) {
         app_state.test_json_path = strdup(test_json_path);
         /* Default baseline path: same directory as latest.json */
@@ -108,177 +361,115 @@ int main(int argc, char *argv[]) {
             }
         }
     }
-    int64_t last_poll = 0;
+
+    /* Start background polling (after tui_init so its signal handlers are
+     * installed before the poller thread blocks them) */
+    poller_t poller;
+    if (!poller_start(&poller, app_state.poll_interval_ms)) {
+        tab_system_fini(&tabs);
+        tui_fini();
+        fprintf(stderr, "ERROR: Failed to start poller\n");
+        return 1;
+    }
 
     /* Main loop */
+    bool redraw = true;  /* header/footer need repainting */
     while (g_running) {
-        /* Step 1: Input -- global keys first, then tab switching, then per-tab */
-        int ch = getch();
-
-        if (ch == 'q' || ch == 'Q') {
-            g_running = 0;
-            continue;
+        /* Step 1: Input -- drain every key that arrived since the last wake
+         * (getch is non-blocking, the wait happens in poll() below) */
+        int ch;
+        while (g_running && (ch = getch()) != ERR) {
+            if (!handle_key(ch, &tabs, &app_state)) g_running = 0;
+            redraw = true;
         }
+        if (!g_running) break;
 
-        if (ch == KEY_RESIZE) {
-            tui_resize();
+        /* Step 2: Tell the poller what the active tab needs, then install
+         * the latest finished generation (never waits on the network) */
+        bool have_detail = app_state.entity_detail && app_state.selected_entity_path &&
+            app_state.entity_detail->path &&
+            strcmp(app_state.entity_detail->path, app_state.selected_entity_path) == 0;
+        /* World stats feed the histories on every tab. The component
+         * registry feeds footprint trends, polled in the background only
+         * with -f; an armed spike trigger also needs current pipeline
+         * stats and the raw bodies */
+        bool spikes_armed = app_state.spikes.trigger.mode != SPIKE_MODE_OFF;
+        uint32_t endpoints = tab_system_required_endpoints(&tabs) | ENDPOINT_STATS_WORLD;
+        if (track_footprints) endpoints |= ENDPOINT_COMPONENTS;
+        if (spikes_armed) endpoints |= ENDPOINT_STATS_PIPELINE;
+        /* In bulk mode one /world dump stands in for whichever of those
+         * datasets were asked for; tabs that need none of them skip it */
+        if (bulk && (endpoints & WORLD_DUMP_ENDPOINTS)) {
+            endpoints = (endpoints & ~WORLD_DUMP_ENDPOINTS) | ENDPOINT_WORLD;
         }
+        poller_set_request(&poller, endpoints,
+                           app_state.selected_entity_path, have_detail,
+                           spikes_armed, app_state.poll_interval_ms);
 
-        /* Esc key: pop nav stack or pass to active tab */
-        if (ch == 27) {
-            nav_entry_t entry;
-            if (nav_pop(&app_state.nav_stack, &entry)) {
-                tab_system_activate(&tabs, entry.tab_index);
-                /* Restore entity selection if possible */
-                if (entry.entity_id != 0 && app_state.entity_list) {
-                    for (int i = 0; i < app_state.entity_list->count; i++) {
-                        entity_node_t *n = app_state.entity_list->nodes[i];
-                        if (n->id == entry.entity_id && n->full_path) {
-                            free(app_state.selected_entity_path);
-                            app_state.selected_entity_path = strdup(n->full_path);
-                            break;
-                        }
-                    }
-                }
-            } else {
-                /* No nav history -- pass to tab */
-                tab_system_handle_input(&tabs, ch, &app_state);
+        int64_t now = now_ms();
+        poll_result_t *result = poller_take(&poller);
+        if (result) {
+            connection_state_t prev_conn = app_state.conn_state;
+            uint32_t changed = apply_poll_result(&app_state, result, now);
+            poll_result_free(result);
+            tab_system_mark_dirty(&tabs, changed);
+            if (app_state.conn_state != prev_conn || app_state.footer_message) {
+                redraw = true;
             }
-        } else if (ch >= '1' && ch <= '0' + TAB_COUNT) {
-            /* Direct tab switch -- clear nav stack (new context) */
-            nav_clear(&app_state.nav_stack);
-            tab_system_activate(&tabs, ch - '1');
-        } else if (ch == '\t') {
-            /* Tab key -- clear nav stack (new context) */
-            nav_clear(&app_state.nav_stack);
-            tab_system_next(&tabs);
-        } else if (ch != ERR) {
-            tab_system_handle_input(&tabs, ch, &app_state);
         }
 
-        /* Cross-tab navigation (e.g., Systems tab -> CELS tab) */
-        if (app_state.pending_tab >= 0) {
-            /* Push current tab onto nav stack before switching */
-            nav_push(&app_state.nav_stack, tabs.active, 0);
-            tab_system_activate(&tabs, app_state.pending_tab);
-            app_state.pending_tab = -1;
+        /* Expire footer message */
+        if (app_state.footer_message && now >= app_state.footer_message_expire) {
+            free(app_state.footer_message);
+            app_state.footer_message = NULL;
+            redraw = true;
         }
 
-        /* Step 2: Poll on timer -- always poll /stats/world for connection health.
-         * Only update snapshot data if the active tab needs ENDPOINT_STATS_WORLD. */
-        int64_t now = now_ms();
-        if (now - last_poll >= app_state.poll_interval_ms) {
-            uint32_t needed = tab_system_required_endpoints(&tabs);
-
-            http_response_t resp = http_get(curl, url);
-            app_state.conn_state =
-                connection_state_update(app_state.conn_state, resp.status);
-
-            /* Only parse and store snapshot if active tab needs world stats */
-            if ((needed & ENDPOINT_STATS_WORLD) &&
-                resp.status == 200 && resp.body.data) {
-                world_snapshot_t *new_snap =
-                    json_parse_world_stats(resp.body.data, resp.body.size);
-                if (new_snap) {
-                    world_snapshot_free(app_state.snapshot);
-                    app_state.snapshot = new_snap;
-                }
-            }
-
-            http_response_free(&resp);
-            last_poll = now;
-
-            /* Poll entity list if active tab needs it */
-            if ((needed & ENDPOINT_QUERY) && app_state.conn_state == CONN_CONNECTED) {
-                static const char *entity_list_url =
-                    "http://localhost:27750/query"
-                    "?expr=!ChildOf(self%7Cup%2Cflecs)%2C!Module(self%7Cup)"
-                    "&entity_id=true&values=false&table=true&try=true";
-                http_response_t qresp = http_get(curl, entity_list_url);
-                if (qresp.status == 200 && qresp.body.data) {
-                    entity_list_t *new_list =
-                        json_parse_entity_list(qresp.body.data, qresp.body.size);
-                    if (new_list) {
-                        entity_list_free(app_state.entity_list);
-                        app_state.entity_list = new_list;
-                    }
-                }
-                http_response_free(&qresp);
-            }
-
-            /* Poll selected entity detail if an entity is selected */
-            if ((needed & ENDPOINT_ENTITY) && app_state.selected_entity_path &&
-                app_state.conn_state == CONN_CONNECTED) {
-                char entity_url[512];
-                snprintf(entity_url, sizeof(entity_url),
-                    "http://localhost:27750/entity/%s?entity_id=true&try=true&doc=true",
-                    app_state.selected_entity_path);
-                http_response_t eresp = http_get(curl, entity_url);
-                if (eresp.status == 200 && eresp.body.data) {
-                    entity_detail_t *new_detail =
-                        json_parse_entity_detail(eresp.body.data, eresp.body.size);
-                    if (new_detail) {
-                        entity_detail_free(app_state.entity_detail);
-                        app_state.entity_detail = new_detail;
-                    }
-                } else if (eresp.status == 404 || eresp.status == -1) {
-                    /* Entity was deleted -- clear detail and notify */
-                    entity_detail_free(app_state.entity_detail);
-                    app_state.entity_detail = NULL;
-                    /* Set footer notification */
-                    free(app_state.footer_message);
-                    app_state.footer_message = strdup("Selected entity removed");
-                    app_state.footer_message_expire = now + 3000; /* 3 seconds */
-                    free(app_state.selected_entity_path);
-                    app_state.selected_entity_path = NULL;
-                }
-                http_response_free(&eresp);
-            }
-
-            /* Poll component registry if active tab needs it */
-            if ((needed & ENDPOINT_COMPONENTS) && app_state.conn_state == CONN_CONNECTED) {
-                http_response_t cresp = http_get(curl,
-                    "http://localhost:27750/components?try=true");
-                if (cresp.status == 200 && cresp.body.data) {
-                    component_registry_t *new_reg =
-                        json_parse_component_registry(cresp.body.data, cresp.body.size);
-                    if (new_reg) {
-                        component_registry_free(app_state.component_registry);
-                        app_state.component_registry = new_reg;
-                    }
-                }
-                http_response_free(&cresp);
-            }
-
-            /* Poll pipeline stats if active tab needs it */
-            if ((needed & ENDPOINT_STATS_PIPELINE) && app_state.conn_state == CONN_CONNECTED) {
-                http_response_t presp = http_get(curl,
-                    "http://localhost:27750/stats/pipeline");
-                if (presp.status == 200 && presp.body.data) {
-                    system_registry_t *new_reg =
-                        json_parse_pipeline_stats(presp.body.data, presp.body.size);
-                    if (new_reg) {
-                        system_registry_free(app_state.system_registry);
-                        app_state.system_registry = new_reg;
-                    }
-                }
-                http_response_free(&presp);
-            }
+        /* Timed redraw the active tab asked for (e.g. end of a highlight) */
+        int64_t tab_deadline = tab_system_redraw_deadline(&tabs);
+        if (tab_deadline > 0 && now >= tab_deadline) {
+            tabs.tabs[tabs.active].dirty = true;
+        }
 
-            /* Expire footer message */
-            if (app_state.footer_message && now >= app_state.footer_message_expire) {
-                free(app_state.footer_message);
-                app_state.footer_message = NULL;
-            }
+        /* Step 3: Render -- only when something visible changed */
+        if (redraw || tab_system_needs_draw(&tabs)) {
+            tui_render(&tabs, &app_state);
+            redraw = false;
         }
 
-        /* Step 3: Render */
-        tui_render(&tabs, &app_state);
+        /* Step 4: Sleep until a key, a new generation, or the next timed
+         * event (footer expiry, tab redraw deadline). SIGWINCH interrupts
+         * poll() with EINTR; getch() then reports KEY_RESIZE. */
+        int64_t deadline = 0;
+        if (app_state.footer_message) deadline = app_state.footer_message_expire;
+        tab_deadline = tab_system_redraw_deadline(&tabs);
+        if (tab_deadline > 0 && (deadline == 0 || tab_deadline < deadline)) {
+            deadline = tab_deadline;
+        }
+        int wait_ms = -1;
+        if (deadline > 0) {
+            int64_t left = deadline - now_ms();
+            wait_ms = left > 0 ? (int)left : 0;
+        }
+        struct pollfd fds[2] = {
+            { .fd = STDIN_FILENO,               .events = POLLIN },
+            { .fd = poller_notify_fd(&poller),  .events = POLLIN },
+        };
+        if (poll(fds, 2, wait_ms) < 0 && errno != EINTR) {
+            break;
+        }
     }
 
     /* Cleanup -- reverse of init order */
+    poller_stop(&poller);
     tab_system_fini(&tabs);
     world_snapshot_free(app_state.snapshot);
+    metric_history_fini(&app_state.world_history);
+    metric_history_fini(&app_state.pipeline_history);
+    quantile_tracker_free(app_state.frame_quantiles);
+    spike_log_fini(&app_state.spikes);
+    system_index_fini(&app_state.system_index);
+    footprint_tracker_fini(&app_state.footprints);
     entity_list_free(app_state.entity_list);
     entity_detail_free(app_state.entity_detail);
     component_registry_free(app_state.component_registry);
@@ -288,8 +479,8 @@ int main(int argc, char *argv[]) {
     free(app_state.baseline_json_path);
     free(app_state.selected_entity_path);
     free(app_state.footer_message);
-    http_client_fini(curl);
     tui_fini();
+    intern_fini();  /* after every entity list is gone */
 
     return 0;
 }
@@ -0,0 +1,148 @@
+#define _POSIX_C_SOURCE 200809L
+#include "metric_catalog.h"
+#include "metric_history.h"   /* METRIC_SAMPLE_HZ */
+#include <stdio.h>
+#include <string.h>
+
+#define G METRIC_KIND_GAUGE
+#define C METRIC_KIND_COUNTER
+#define N METRIC_UNIT_COUNT
+#define S METRIC_UNIT_SECONDS
+
+/* flecs world statistics (ecs_world_stats_t), by response key */
+static const metric_info_t CATALOG[] = {
+    { "entities.count",                        "Entities",            G, N },
+    { "entities.not_alive_count",              "Dead entity ids",     G, N },
+
+    { "components.tag_count",                  "Tags",                G, N },
+    { "components.component_count",            "Components",          G, N },
+    { "components.pair_count",                 "Pairs",               G, N },
+    { "components.type_count",                 "Type ids",            G, N },
+    { "components.create_count",               "Ids created",         C, N },
+    { "components.delete_count",               "Ids deleted",         C, N },
+
+    { "tables.count",                          "Tables",              G, N },
+    { "tables.empty_count",                    "Empty tables",        G, N },
+    { "tables.create_count",                   "Tables created",      C, N },
+    { "tables.delete_count",                   "Tables deleted",      C, N },
+
+    { "queries.query_count",                   "Queries",             G, N },
+    { "queries.observer_count",                "Observers",           G, N },
+    { "queries.system_count",                  "Systems",             G, N },
+
+    { "commands.add_count",                    "Cmd add",             C, N },
+    { "commands.remove_count",                 "Cmd remove",          C, N },
+    { "commands.delete_count",                 "Cmd delete",          C, N },
+    { "commands.clear_count",                  "Cmd clear",           C, N },
+    { "commands.set_count",                    "Cmd set",             C, N },
+    { "commands.ensure_count",                 "Cmd ensure",          C, N },
+    { "commands.modified_count",               "Cmd modified",        C, N },
+    { "commands.other_count",                  "Cmd other",           C, N },
+    { "commands.discard_count",                "Cmd discarded",       C, N },
+    { "commands.batched_entity_count",         "Batched entities",    C, N },
+    { "commands.batched_count",                "Batched commands",    C, N },
+
+    { "frame.frame_count",                     "Frames",              C, N },
+    { "frame.merge_count",                     "Merges",              C, N },
+    { "frame.rematch_count",                   "Rematches",           C, N },
+    { "frame.pipeline_build_count",            "Pipeline rebuilds",   C, N },
+    { "frame.systems_ran",                     "Systems ran",         C, N },
+    { "frame.observers_ran",                   "Observers ran",       C, N },
+    { "frame.event_emit_count",                "Events emitted",      C, N },
+
+    { "performance.world_time_raw",            "World time (raw)",    C, S },
+    { "performance.world_time",                "World time",          C, S },
+    { "performance.frame_time",                "Frame time",          C, S },
+    { "performance.system_time",               "System time",         C, S },
+    { "performance.emit_time",                 "Emit time",           C, S },
+    { "performance.merge_time",                "Merge time",          C, S },
+    { "performance.rematch_time",              "Rematch time",        C, S },
+    { "performance.fps",                       "FPS",                 G, METRIC_UNIT_HERTZ },
+    { "performance.delta_time",                "Delta time",          G, S },
+
+    { "memory.alloc_count",                    "Allocations",         C, N },
+    { "memory.realloc_count",                  "Reallocations",       C, N },
+    { "memory.free_count",                     "Frees",               C, N },
+    { "memory.outstanding_alloc_count",        "Live allocations",    G, N },
+    { "memory.block_alloc_count",              "Block allocs",        C, N },
+    { "memory.block_free_count",               "Block frees",         C, N },
+    { "memory.block_outstanding_alloc_count",  "Live blocks",         G, N },
+    { "memory.stack_alloc_count",              "Stack allocs",        C, N },
+    { "memory.stack_free_count",               "Stack frees",         C, N },
+    { "memory.stack_outstanding_alloc_count",  "Live stack allocs",   G, N },
+
+    { "http.request_received_count",           "HTTP requests",       C, N },
+    { "http.request_invalid_count",            "HTTP invalid",        C, N },
+    { "http.request_handled_ok_count",         "HTTP ok",             C, N },
+    { "http.request_handled_error_count",      "HTTP errors",         C, N },
+    { "http.request_not_handled_count",        "HTTP not handled",    C, N },
+    { "http.request_preflight_count",          "HTTP preflight",      C, N },
+    { "http.send_ok_count",                    "HTTP sent",           C, N },
+    { "http.send_error_count",                 "HTTP send errors",    C, N },
+    { "http.busy_count",                       "HTTP busy",           C, N },
+};
+
+#undef G
+#undef C
+#undef N
+#undef S
+
+static const metric_info_t *find(const char *name) {
+    if (!name) return NULL;
+    for (size_t i = 0; i < sizeof(CATALOG) / sizeof(CATALOG[0]); i++) {
+        if (strcmp(CATALOG[i].name, name) == 0) return &CATALOG[i];
+    }
+    return NULL;
+}
+
+metric_info_t metric_catalog_describe(const char *name) {
+    const metric_info_t *known = find(name);
+    if (known) return *known;
+    return (metric_info_t){ name, name ? name : "?", METRIC_KIND_GAUGE, METRIC_UNIT_COUNT };
+}
+
+bool metric_catalog_known(const char *name) {
+    return find(name) != NULL;
+}
+
+double metric_catalog_value(const metric_info_t *info, double raw) {
+    if (info->unit == METRIC_UNIT_SECONDS) return raw * 1000.0;
+    if (info->kind == METRIC_KIND_COUNTER) return raw * METRIC_SAMPLE_HZ;
+    return raw;
+}
+
+void metric_catalog_format(const metric_info_t *info, double value,
+                           char *buf, size_t size) {
+    switch (info->unit) {
+    case METRIC_UNIT_SECONDS:
+        snprintf(buf, size, "%.2fms", value);
+        break;
+    case METRIC_UNIT_HERTZ:
+        snprintf(buf, size, "%.1f", value);
+        break;
+    default:
+        if (info->kind == METRIC_KIND_COUNTER) {
+            snprintf(buf, size, "%.1f/s", value);
+        } else {
+            snprintf(buf, size, "%.0f", value);
+        }
+        break;
+    }
+}
+
+int metric_dashboard_parse(const char *spec, intern_id_t *out, int max) {
+    int count = 0;
+    const char *p = spec;
+    while (p) {
+        const char *comma = strchr(p, ',');
+        size_t len = comma ? (size_t)(comma - p) : strlen(p);
+        if (len == 0) return -1;
+
+        intern_id_t id = intern_n(p, len);
+        bool dup = false;
+        for (int i = 0; i < count; i++) dup = dup || out[i] == id;
+        if (id != INTERN_NONE && !dup && count < max) out[count++] = id;
+        p = comma ? comma + 1 : NULL;
+    }
+    return count;
+}
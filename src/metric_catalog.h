@@ -0,0 +1,67 @@
+#ifndef CELS_DEBUG_METRIC_CATALOG_H
+#define CELS_DEBUG_METRIC_CATALOG_H
+
+#include "intern.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* What the /stats/world metrics mean.
+ *
+ * The parser keeps every metric window of the response and the world
+ * history records all of them by name; this catalog adds how to read one.
+ * flecs reports gauges as the value at each sample and counters as the
+ * increment during each sample, so a counter's readable form is a rate
+ * (samples come METRIC_SAMPLE_HZ per second). Time metrics are reported
+ * in seconds and shown in ms. Metrics the catalog does not know are shown
+ * as plain gauges under their own name.
+ *
+ * The Overview dashboard shows a configurable list of metrics (-m), by
+ * default the ones that expose allocation rate, table churn and query
+ * count. */
+
+typedef enum metric_kind {
+    METRIC_KIND_GAUGE,
+    METRIC_KIND_COUNTER,
+} metric_kind_t;
+
+typedef enum metric_unit {
+    METRIC_UNIT_COUNT,
+    METRIC_UNIT_SECONDS,     /* shown in ms */
+    METRIC_UNIT_HERTZ,
+} metric_unit_t;
+
+typedef struct metric_info {
+    const char   *name;      /* flecs key, e.g. "tables.create_count" */
+    const char   *label;     /* short display name, e.g. "Tables created" */
+    metric_kind_t kind;
+    metric_unit_t unit;
+} metric_info_t;
+
+#define METRIC_DASHBOARD_MAX 16
+
+/* Comma-separated default dashboard (-m overrides it) */
+#define METRIC_DASHBOARD_DEFAULT \
+    "memory.alloc_count,memory.outstanding_alloc_count," \
+    "tables.count,tables.empty_count,tables.create_count,tables.delete_count," \
+    "queries.query_count,queries.observer_count"
+
+/* Catalog entry for a metric. Unknown names get a generic gauge entry
+ * whose label is the name itself (name must then outlive the result). */
+metric_info_t metric_catalog_describe(const char *name);
+
+/* True if the catalog has an entry for name. */
+bool metric_catalog_known(const char *name);
+
+/* Convert a raw sample (or the mean of several) to display units: ms for
+ * time, per second for counters. */
+double metric_catalog_value(const metric_info_t *info, double raw);
+
+/* Format a display value with its unit, e.g. "12.5/s", "3.21ms", "840". */
+void metric_catalog_format(const metric_info_t *info, double value,
+                           char *buf, size_t size);
+
+/* Parse a comma-separated metric list into intern ids (at most max,
+ * duplicates dropped). Returns the count, or -1 on an empty entry. */
+int metric_dashboard_parse(const char *spec, intern_id_t *out, int max);
+
+#endif /* CELS_DEBUG_METRIC_CATALOG_H */
@@ -0,0 +1,345 @@
+#define _POSIX_C_SOURCE 200809L
+#include "metric_history.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Keep in sync with metric_tier_t */
+static const int TIER_SPAN[METRIC_TIER_COUNT] = {
+    [METRIC_TIER_SECOND] = METRIC_SAMPLE_HZ,          /* 1 s buckets */
+    [METRIC_TIER_MINUTE] = 60 * METRIC_SAMPLE_HZ,     /* 1 min buckets */
+};
+/* Buckets kept per tier unless the history asks for fewer */
+static const int TIER_CAPACITY_DEFAULT[METRIC_TIER_COUNT] = {
+    [METRIC_TIER_SECOND] = 3600,                      /* 1 h */
+    [METRIC_TIER_MINUTE] = 1440,                      /* 24 h */
+};
+
+int metric_tier_span(metric_tier_t tier) { return TIER_SPAN[tier]; }
+
+int metric_tier_capacity(const metric_history_t *h, metric_tier_t tier) {
+    return h->tier_capacity[tier];
+}
+
+static size_t series_bytes(const metric_history_t *h) {
+    size_t bytes = METRIC_HISTORY_CAPACITY * sizeof(metric_sample_t);
+    for (int t = 0; t < METRIC_TIER_COUNT; t++) {
+        bytes += (size_t)h->tier_capacity[t] * sizeof(metric_bucket_t);
+    }
+    return bytes;
+}
+
+/* --- Window alignment --- */
+
+static inline uint64_t mix_double(uint64_t h, double d) {
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    return hash_u64(h ^ bits);
+}
+
+/* One fingerprint per sample index over every metric's avg/min/max, so two
+ * windows can be aligned by comparing n integers instead of n * metrics. */
+static void window_fingerprint(const metric_window_set_t *set, uint64_t *fp) {
+    for (int i = 0; i < set->window_len; i++) {
+        uint64_t h = 0x9e3779b97f4a7c15ull;
+        for (int m = 0; m < set->count; m++) {
+            const metric_window_t *mw = &set->metrics[m];
+            h = mix_double(h, mw->avg[i]);
+            h = mix_double(h, mw->min[i]);
+            h = mix_double(h, mw->max[i]);
+        }
+        fp[i] = h;
+    }
+}
+
+/* Number of samples at the end of the new window that the previous window
+ * did not contain. The window moved by k samples if the first n - k new
+ * fingerprints equal the last n - k old ones. Flat metrics can match at
+ * several shifts; the one closest to the elapsed wall time wins. No match
+ * means the polls were further apart than one window: everything is new,
+ * and *holes receives the samples flecs produced between the two windows
+ * that no poll saw, so the clock keeps up with wall time. */
+static int new_sample_count(metric_history_t *h, const uint64_t *fp, int n,
+                            int64_t elapsed_ms, uint64_t *holes) {
+    *holes = 0;
+    if (!h->window_fp) return n;
+
+    int64_t elapsed = elapsed_ms * METRIC_SAMPLE_HZ / 1000;
+    if (elapsed < 0) elapsed = 0;
+    int64_t expected = elapsed > n ? n : elapsed;
+
+    int best = -1;
+    for (int k = 0; h->window_len == n && k < n; k++) {
+        if (memcmp(fp, h->window_fp + k, (size_t)(n - k) * sizeof(uint64_t)) != 0) {
+            continue;
+        }
+        if (best < 0 || llabs(k - expected) < llabs(best - expected)) best = k;
+    }
+    if (best >= 0) return best;
+
+    h->gaps++;
+    if (elapsed > n) *holes = (uint64_t)(elapsed - n);
+    return n;
+}
+
+/* --- Series --- */
+
+static metric_series_t *series_for(metric_history_t *h, intern_id_t name) {
+    uintptr_t slot = (uintptr_t)u64_map_get(&h->by_name, name);
+    if (slot != 0) return &h->series[slot - 1];
+    if (h->series_count >= h->max_series) return NULL;
+
+    if (h->series_count == h->series_capacity) {
+        int cap = h->series_capacity == 0 ? 64 : h->series_capacity * 2;
+        if (cap > h->max_series) cap = h->max_series;
+        metric_series_t *grown = realloc(h->series, (size_t)cap * sizeof(*grown));
+        if (!grown) return NULL;
+        h->series = grown;
+        h->series_capacity = cap;
+    }
+
+    /* Raw ring and every tier in one zeroed block (count 0 = empty bucket) */
+    unsigned char *block = calloc(1, series_bytes(h));
+    if (!block) return NULL;
+    metric_series_t *s = &h->series[h->series_count];
+    s->name = name;
+    s->first_seq = h->seq;
+    s->end_seq = h->seq;
+    s->ring = (metric_sample_t *)block;
+    block += METRIC_HISTORY_CAPACITY * sizeof(metric_sample_t);
+    for (int t = 0; t < METRIC_TIER_COUNT; t++) {
+        s->tier[t] = h->tier_capacity[t] > 0 ? (metric_bucket_t *)block : NULL;
+        block += (size_t)h->tier_capacity[t] * sizeof(metric_bucket_t);
+    }
+    if (!u64_map_put(&h->by_name, name, (void *)(uintptr_t)(h->series_count + 1))) {
+        free(s->ring);
+        memset(s, 0, sizeof(*s));
+        return NULL;
+    }
+    h->series_count++;
+    return s;
+}
+
+static void bucket_merge(metric_bucket_t *dst, const metric_bucket_t *src) {
+    if (src->count == 0) return;
+    if (dst->count == 0) {
+        *dst = *src;
+        return;
+    }
+    uint32_t total = dst->count + src->count;
+    dst->avg = (dst->avg * (float)dst->count + src->avg * (float)src->count) / (float)total;
+    if (src->min < dst->min) dst->min = src->min;
+    if (src->max > dst->max) dst->max = src->max;
+    dst->count = total;
+}
+
+/* Record the sample at s->end_seq (NaN avg = no value) and roll it up: it
+ * joins the current second bucket, and a second bucket that just closed is
+ * folded into its minute bucket. Tiers the history does not keep are
+ * skipped. */
+static void series_push(const metric_history_t *h, metric_series_t *s,
+                        metric_sample_t v) {
+    uint64_t seq = s->end_seq++;
+    s->ring[seq % METRIC_HISTORY_CAPACITY] = v;
+
+    metric_bucket_t *cur[METRIC_TIER_COUNT];
+    for (int t = 0; t < METRIC_TIER_COUNT; t++) {
+        uint64_t span = (uint64_t)TIER_SPAN[t];
+        uint64_t cap = (uint64_t)h->tier_capacity[t];
+        cur[t] = cap > 0 ? &s->tier[t][(seq / span) % cap] : NULL;
+        if (cur[t] && seq % span == 0) *cur[t] = (metric_bucket_t){0};
+    }
+
+    if (cur[0] && !isnan(v.avg)) {
+        bucket_merge(cur[0], &(metric_bucket_t){ v.avg, v.min, v.max, 1 });
+    }
+    for (int t = 1; t < METRIC_TIER_COUNT; t++) {
+        if (!cur[t] || !cur[t - 1]) break;
+        if ((seq + 1) % (uint64_t)TIER_SPAN[t - 1] != 0) break;
+        bucket_merge(cur[t], cur[t - 1]);
+    }
+}
+
+/* Record count samples with no value: count series_push() calls with a
+ * NaN sample, except that whole spans of the coarsest tier are blanked
+ * directly, so a pause of any length costs at most one pass over the
+ * rings. */
+static void series_push_holes(const metric_history_t *h, metric_series_t *s,
+                              uint64_t count) {
+    const metric_sample_t hole = { NAN, NAN, NAN };
+    const uint64_t coarse = (uint64_t)TIER_SPAN[METRIC_TIER_COUNT - 1];
+
+    /* Up to a boundary of the coarsest tier, so every open bucket closes
+     * and folds as usual */
+    while (count > 0 && s->end_seq % coarse != 0) {
+        series_push(h, s, hole);
+        count--;
+    }
+
+    uint64_t whole = count / coarse * coarse;
+    if (whole > 0) {
+        uint64_t seq = s->end_seq;
+        uint64_t first = whole > METRIC_HISTORY_CAPACITY ? whole - METRIC_HISTORY_CAPACITY : 0;
+        for (uint64_t i = first; i < whole; i++) {
+            s->ring[(seq + i) % METRIC_HISTORY_CAPACITY] = hole;
+        }
+        for (int t = 0; t < METRIC_TIER_COUNT; t++) {
+            uint64_t span = (uint64_t)TIER_SPAN[t];
+            uint64_t cap = (uint64_t)h->tier_capacity[t];
+            uint64_t buckets = whole / span;
+            for (uint64_t b = buckets > cap ? buckets - cap : 0; b < buckets; b++) {
+                s->tier[t][(seq / span + b) % cap] = (metric_bucket_t){0};
+            }
+        }
+        s->end_seq += whole;
+        count -= whole;
+    }
+
+    while (count-- > 0) series_push(h, s, hole);
+}
+
+/* --- Public API --- */
+
+void metric_history_init(metric_history_t *h, int max_series, metric_filter_fn keep,
+                         const int *tier_capacity) {
+    memset(h, 0, sizeof(*h));
+    h->max_series = max_series;
+    h->keep = keep;
+    for (int t = 0; t < METRIC_TIER_COUNT; t++) {
+        h->tier_capacity[t] = tier_capacity ? tier_capacity[t] : TIER_CAPACITY_DEFAULT[t];
+    }
+}
+
+void metric_history_fini(metric_history_t *h) {
+    for (int i = 0; i < h->series_count; i++) {
+        free(h->series[i].ring);
+    }
+    free(h->series);
+    u64_map_fini(&h->by_name);
+    free(h->window_fp);
+    memset(h, 0, sizeof(*h));
+}
+
+int metric_history_ingest(metric_history_t *h, const metric_window_set_t *set,
+                          int64_t now_ms) {
+    if (!set || set->count == 0 || set->window_len == 0) return 0;
+
+    int n = set->window_len;
+    uint64_t *fp = malloc((size_t)n * sizeof(uint64_t));
+    if (!fp) return 0;
+    window_fingerprint(set, fp);
+
+    uint64_t holes;
+    int fresh = new_sample_count(h, fp, n, now_ms - h->last_ingest_ms, &holes);
+    free(h->window_fp);
+    h->window_fp = fp;
+    h->window_len = n;
+    h->last_ingest_ms = now_ms;
+    if (fresh == 0) return 0;
+    if (fresh > METRIC_HISTORY_CAPACITY) fresh = METRIC_HISTORY_CAPACITY;
+
+    /* Samples between the two windows that no poll saw */
+    h->seq += holes;
+    for (int i = 0; i < h->series_count; i++) {
+        series_push_holes(h, &h->series[i], h->seq - h->series[i].end_seq);
+    }
+
+    h->dropped = 0;
+    for (int m = 0; m < set->count; m++) {
+        const metric_window_t *mw = &set->metrics[m];
+        if (h->keep && !h->keep(intern_str(mw->name))) continue;
+        metric_series_t *s = series_for(h, mw->name);
+        if (!s) {
+            h->dropped++;
+            continue;
+        }
+        if (s->end_seq != h->seq) continue;  /* duplicate name */
+        for (int src = n - fresh; src < n; src++) {
+            series_push(h, s, (metric_sample_t){ (float)mw->avg[src],
+                                              (float)mw->min[src],
+                                              (float)mw->max[src] });
+        }
+    }
+
+    /* Metrics missing from this response get explicit holes, not stale data */
+    h->seq += (uint64_t)fresh;
+    for (int i = 0; i < h->series_count; i++) {
+        series_push_holes(h, &h->series[i], h->seq - h->series[i].end_seq);
+    }
+    return fresh;
+}
+
+const metric_series_t *metric_history_find(const metric_history_t *h, const char *name) {
+    intern_id_t id = intern_find(name);
+    if (id == INTERN_NONE) return NULL;
+    uintptr_t slot = (uintptr_t)u64_map_get(&h->by_name, id);
+    return slot != 0 ? &h->series[slot - 1] : NULL;
+}
+
+int metric_history_recent(const metric_history_t *h, const metric_series_t *s,
+                          metric_sample_t *out, int max) {
+    if (!s || max <= 0) return 0;
+
+    uint64_t lo = s->first_seq;
+    if (h->seq - lo > METRIC_HISTORY_CAPACITY) lo = h->seq - METRIC_HISTORY_CAPACITY;
+    if (h->seq - lo > (uint64_t)max) lo = h->seq - (uint64_t)max;
+
+    int count = 0;
+    for (uint64_t seq = lo; seq < h->seq; seq++) {
+        out[count++] = s->ring[seq % METRIC_HISTORY_CAPACITY];
+    }
+    return count;
+}
+
+int metric_history_buckets(const metric_history_t *h, const metric_series_t *s,
+                           metric_tier_t tier, metric_bucket_t *out, int max) {
+    if (!s || max <= 0 || h->seq <= s->first_seq) return 0;
+
+    uint64_t span = (uint64_t)TIER_SPAN[tier];
+    uint64_t cap = (uint64_t)h->tier_capacity[tier];
+    if (cap == 0) return 0;
+    uint64_t end = (h->seq - 1) / span + 1;     /* one past the filling bucket */
+    uint64_t lo = s->first_seq / span;
+    if (end - lo > cap) lo = end - cap;
+    if (end - lo > (uint64_t)max) lo = end - (uint64_t)max;
+
+    int count = 0;
+    for (uint64_t b = lo; b < end; b++) {
+        out[count++] = s->tier[tier][b % cap];
+    }
+    return count;
+}
+
+metric_stats_t metric_history_stats(const metric_history_t *h, const metric_series_t *s,
+                                    int max) {
+    metric_stats_t st = {0};
+    if (!s || max <= 0) return st;
+
+    uint64_t lo = s->first_seq;
+    if (h->seq - lo > METRIC_HISTORY_CAPACITY) lo = h->seq - METRIC_HISTORY_CAPACITY;
+    if (h->seq - lo > (uint64_t)max) lo = h->seq - (uint64_t)max;
+
+    /* Welford's running mean/variance -- one pass, no cancellation */
+    double mean = 0.0, m2 = 0.0;
+    for (uint64_t seq = lo; seq < h->seq; seq++) {
+        const metric_sample_t *v = &s->ring[seq % METRIC_HISTORY_CAPACITY];
+        if (isnan(v->avg)) continue;
+        st.count++;
+        double d = v->avg - mean;
+        mean += d / st.count;
+        m2 += d * (v->avg - mean);
+        if (st.count == 1 || v->min < st.min) st.min = v->min;
+        if (st.count == 1 || v->max > st.max) st.max = v->max;
+    }
+    if (st.count == 0) return st;
+    st.avg = mean;
+    st.stddev = st.count > 1 ? sqrt(m2 / (st.count - 1)) : 0.0;
+    return st;
+}
+
+size_t metric_history_bytes(const metric_history_t *h) {
+    return (size_t)h->series_count * series_bytes(h) +
+           (size_t)h->series_capacity * sizeof(metric_series_t) +
+           h->by_name.capacity * sizeof(u64_map_slot_t);
+}
@@ -0,0 +1,139 @@
+#ifndef CELS_DEBUG_METRIC_HISTORY_H
+#define CELS_DEBUG_METRIC_HISTORY_H
+
+#include "data_model.h"
+#include "hash_map.h"
+#include "intern.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Rolling, multi-resolution history of stats metrics.
+ *
+ * flecs reports each metric as its last 60 samples (avg/min/max, one sample
+ * per 1/60 s). Consecutive polls return overlapping windows, so each ingest
+ * aligns the new window against the previous one and appends only the
+ * samples that were not seen yet. All series of a history share one sample
+ * clock (seq), which keeps the metrics aligned for side-by-side display.
+ * Polls further apart than one window (slow -r, a paused endpoint) leave
+ * the samples in between as NaN holes, so seq follows wall time.
+ *
+ * Samples are kept at three resolutions:
+ *   raw      METRIC_HISTORY_CAPACITY samples         (1 min at 60 Hz)
+ *   second   1 s buckets for 1 h
+ *   minute   1 min buckets for 24 h
+ * Every raw sample lands in the current second bucket; each second bucket
+ * is folded into its minute bucket when it closes. A history can keep
+ * fewer buckets per tier, or none (tier_capacity). All rings are allocated
+ * when a series first appears, so memory is fixed no matter how long the
+ * session runs: about 120 KB per series with every tier (43 KB raw
+ * only), at most max_series series.
+ * Values are stored as float -- plenty for display, half the memory.
+ *
+ * A filter keeps the history to the metrics the UI reads. Metrics that
+ * pass it but find max_series reached are not recorded; the last ingest's
+ * count of them is kept in dropped so the UI can say so.
+ *
+ * Owned by the UI thread. */
+
+#define METRIC_HISTORY_CAPACITY   3600  /* raw samples per series: 1 min at 60 Hz */
+#define METRIC_SAMPLE_HZ          60    /* flecs' 1s stats window: 60 samples */
+
+typedef enum metric_tier {
+    METRIC_TIER_SECOND,
+    METRIC_TIER_MINUTE,
+    METRIC_TIER_COUNT
+} metric_tier_t;
+
+typedef struct metric_sample {
+    float avg;
+    float min;
+    float max;
+} metric_sample_t;
+
+/* Rollup of every sample in one time span. count == 0: no data. */
+typedef struct metric_bucket {
+    float    avg;
+    float    min;
+    float    max;
+    uint32_t count;
+} metric_bucket_t;
+
+typedef struct metric_series {
+    intern_id_t      name;       /* e.g. "performance.frame_time" */
+    uint64_t         first_seq;  /* first sample recorded for this series */
+    uint64_t         end_seq;    /* one past the last sample recorded */
+    metric_sample_t *ring;       /* METRIC_HISTORY_CAPACITY entries; NaN avg = no sample */
+    metric_bucket_t *tier[METRIC_TIER_COUNT];  /* share ring's allocation */
+} metric_series_t;
+
+/* Whether a metric (by name) is worth recording */
+typedef bool (*metric_filter_fn)(const char *name);
+
+typedef struct metric_history {
+    metric_series_t *series;         /* grows up to max_series; moves on growth */
+    int              series_count;
+    int              series_capacity;
+    int              max_series;
+    int              tier_capacity[METRIC_TIER_COUNT];  /* buckets per tier, 0 = not kept */
+    metric_filter_fn keep;           /* NULL = record every metric */
+    int              dropped;        /* metrics of the last ingest left out at max_series */
+    u64_map_t        by_name;        /* intern id -> series index + 1 */
+    uint64_t         seq;            /* samples appended so far */
+    uint64_t        *window_fp;      /* per-sample fingerprint of the last window */
+    int              window_len;
+    int64_t          last_ingest_ms; /* timestamp of the last ingest */
+    uint64_t         gaps;           /* ingests that did not overlap the previous window */
+} metric_history_t;
+
+/* Samples per bucket, and buckets a history keeps, per tier. */
+int metric_tier_span(metric_tier_t tier);
+int metric_tier_capacity(const metric_history_t *h, metric_tier_t tier);
+
+/* Start empty, holding at most max_series metrics that pass keep (NULL
+ * keeps all). Extra ones are counted in dropped and otherwise ignored.
+ * tier_capacity gives the buckets kept per tier (0 = none, reads return
+ * nothing); NULL keeps the full hour of seconds and day of minutes. */
+void metric_history_init(metric_history_t *h, int max_series, metric_filter_fn keep,
+                         const int *tier_capacity);
+void metric_history_fini(metric_history_t *h);
+
+/* Append the samples of set's windows that are newer than anything
+ * ingested so far. now_ms breaks ties when flat data aligns at several
+ * shifts. Returns the number of samples appended (0 when the window did
+ * not move). */
+int metric_history_ingest(metric_history_t *h, const metric_window_set_t *set,
+                          int64_t now_ms);
+
+/* Series for a metric name, or NULL if it was never recorded. Valid until
+ * the next ingest. */
+const metric_series_t *metric_history_find(const metric_history_t *h, const char *name);
+
+/* Copy up to max of the most recent raw samples of s into out, oldest
+ * first. Samples the series has no value for have a NaN avg. Returns the
+ * count. */
+int metric_history_recent(const metric_history_t *h, const metric_series_t *s,
+                          metric_sample_t *out, int max);
+
+/* Same for one rollup tier. The newest bucket is still filling. */
+int metric_history_buckets(const metric_history_t *h, const metric_series_t *s,
+                           metric_tier_t tier, metric_bucket_t *out, int max);
+
+/* Summary of the last max raw samples: mean and standard deviation of the
+ * sample averages, extremes from the sample min/max. NaN holes are
+ * skipped; count is the number of samples used (0 = no data). */
+typedef struct metric_stats {
+    double avg;
+    double min;
+    double max;
+    double stddev;
+    int    count;
+} metric_stats_t;
+
+metric_stats_t metric_history_stats(const metric_history_t *h, const metric_series_t *s,
+                                    int max);
+
+/* Bytes held by all series (fixed per series). */
+size_t metric_history_bytes(const metric_history_t *h);
+
+#endif /* CELS_DEBUG_METRIC_HISTORY_H */
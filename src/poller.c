@@ -0,0 +1,423 @@
+#define _POSIX_C_SOURCE 200809L
+#include "poller.h"
+#include "json_parser.h"
+#include "tab_system.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REST_BASE "http://localhost:27750"
+
+/* Receive buffers double as in-situ parse buffers */
+_Static_assert(HTTP_BODY_PADDING >= JSON_INSITU_PADDING,
+               "receive buffer padding too small for in-situ parsing");
+
+static const char *URL_STATS_WORLD    = REST_BASE "/stats/world";
+static const char *URL_STATS_PIPELINE = REST_BASE "/stats/pipeline";
+static const char *URL_COMPONENTS     = REST_BASE "/components?try=true";
+static const char *URL_WORLD          = REST_BASE "/world";
+static const char *URL_ENTITY_LIST    =
+    REST_BASE "/query"
+    "?expr=!ChildOf(self%7Cup%2Cflecs)%2C!Module(self%7Cup)"
+    "&entity_id=true&values=false&table=true&try=true";
+
+static int64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+const char *poll_slot_url(int slot, const char *entity_path, char *buf, size_t size) {
+    switch (slot) {
+    case POLL_SLOT_STATS_WORLD:    return URL_STATS_WORLD;
+    case POLL_SLOT_QUERY:          return URL_ENTITY_LIST;
+    case POLL_SLOT_COMPONENTS:     return URL_COMPONENTS;
+    case POLL_SLOT_STATS_PIPELINE: return URL_STATS_PIPELINE;
+    case POLL_SLOT_WORLD:          return URL_WORLD;
+    case POLL_SLOT_ENTITY:
+        snprintf(buf, size, REST_BASE "/entity/%s?entity_id=true&try=true&doc=true",
+                 entity_path);
+        return buf;
+    default:
+        return NULL;
+    }
+}
+
+/* --- Result lifecycle --- */
+
+void poll_result_free(poll_result_t *r) {
+    if (!r) return;
+    world_snapshot_free(r->snapshot);
+    entity_list_free(r->entity_list);
+    component_registry_free(r->component_registry);
+    system_registry_free(r->system_registry);
+    entity_detail_free(r->entity_detail);
+    free(r->detail_path);
+    free(r);
+}
+
+/* Move every dataset the newer result did not fetch out of the stale one.
+ * The stale result is freed afterwards with whatever is left in it. */
+static void poll_result_carry_over(poll_result_t *newer, poll_result_t *stale) {
+#define CARRY(field) \
+    if (!newer->field && stale->field) { newer->field = stale->field; stale->field = NULL; }
+    CARRY(snapshot);
+    CARRY(entity_list);
+    CARRY(component_registry);
+    CARRY(system_registry);
+#undef CARRY
+    if (!newer->detail_path && stale->detail_path) {
+        newer->detail_path = stale->detail_path;
+        newer->entity_detail = stale->entity_detail;
+        newer->detail_removed = stale->detail_removed;
+        stale->detail_path = NULL;
+        stale->entity_detail = NULL;
+    }
+}
+
+/* Publish a finished generation. Reclaim the unconsumed previous one first
+ * so the carry-over never touches a result the UI can already see. */
+static void publish(poller_t *p, poll_result_t *r) {
+    poll_result_t *stale = atomic_exchange(&p->ready, NULL);
+    if (stale) {
+        poll_result_carry_over(r, stale);
+        poll_result_free(stale);
+    }
+    atomic_store(&p->ready, r);
+
+    /* Wake the UI thread (it poll()s this fd next to stdin) */
+    uint64_t one = 1;
+    ssize_t n = write(p->notify_fd, &one, sizeof(one));
+    (void)n;  /* EAGAIN only if the counter saturated -- UI is due to wake anyway */
+}
+
+/* --- One poll cycle (poller thread) --- */
+
+/* Decide whether a response needs parsing. A 304, or a body identical to
+ * the last one parsed for the slot, means the UI already holds this data. */
+static bool needs_parse(poller_t *p, int slot, const http_response_t *resp) {
+    bool unchanged = resp->status == 304 ||
+        (resp->status == 200 && resp->body_hash != 0 &&
+         resp->body_hash == p->parsed_hash[slot]);
+    if (unchanged) {
+        p->stats[slot].skipped++;
+        return false;
+    }
+    return resp->status == 200 && resp->body.data;
+}
+
+/* Remember what was parsed so the next identical body can be skipped. A
+ * failed parse also drops the ETag: the UI holds nothing a 304 could
+ * refer to, so the next request must fetch the body again. */
+static void note_parsed(poller_t *p, int slot, const http_response_t *resp,
+                        bool ok) {
+    p->stats[slot].parsed++;
+    p->parsed_hash[slot] = ok ? resp->body_hash : 0;
+    if (!ok) http_multi_forget(p->http, slot);
+}
+
+/* NUL-terminated copy of a body, taken before the in-situ parse rewrites it */
+static char *copy_body(const poll_request_t *req, const http_response_t *resp) {
+    if (!req->keep_raw) return NULL;
+    char *copy = malloc(resp->body.size + 1);
+    if (!copy) return NULL;
+    memcpy(copy, resp->body.data, resp->body.size);
+    copy[resp->body.size] = '\0';
+    return copy;
+}
+
+/* Queue every data endpoint the request needs (everything but /stats/world) */
+static void queue_data_requests(poller_t *p, const poll_request_t *req,
+                                char *entity_url, size_t entity_url_size) {
+    if (req->endpoints & ENDPOINT_QUERY) {
+        http_multi_add(p->http, POLL_SLOT_QUERY, URL_ENTITY_LIST);
+    }
+    if (!req->have_detail) {
+        /* The UI dropped (or never got) the detail -- an unchanged
+         * response must be parsed and delivered again */
+        p->parsed_hash[POLL_SLOT_ENTITY] = 0;
+        http_multi_forget(p->http, POLL_SLOT_ENTITY);
+    }
+    if ((req->endpoints & ENDPOINT_ENTITY) && req->entity_path) {
+        http_multi_add(p->http, POLL_SLOT_ENTITY,
+                       poll_slot_url(POLL_SLOT_ENTITY, req->entity_path,
+                                     entity_url, entity_url_size));
+    }
+    if (req->endpoints & ENDPOINT_COMPONENTS) {
+        http_multi_add(p->http, POLL_SLOT_COMPONENTS, URL_COMPONENTS);
+    }
+    if (req->endpoints & ENDPOINT_WORLD) {
+        /* The dump also carries the detail: while the UI lacks it, an
+         * unchanged dump must be parsed and delivered again */
+        if (req->entity_path && !req->have_detail) {
+            p->parsed_hash[POLL_SLOT_WORLD] = 0;
+            http_multi_forget(p->http, POLL_SLOT_WORLD);
+        }
+        http_multi_add(p->http, POLL_SLOT_WORLD, URL_WORLD);
+    }
+    if (req->endpoints & ENDPOINT_STATS_PIPELINE) {
+        http_multi_add(p->http, POLL_SLOT_STATS_PIPELINE, URL_STATS_PIPELINE);
+    }
+}
+
+static poll_result_t *poll_cycle(poller_t *p, const poll_request_t *req) {
+    poll_result_t *r = calloc(1, sizeof(poll_result_t));
+    if (!r) return NULL;
+
+    /* Always poll /stats/world for connection health. While connected, every
+     * other endpoint goes out in the same concurrent batch; otherwise wait
+     * for /stats/world to confirm the connection before issuing the rest. */
+    char entity_url[512];
+    http_multi_add(p->http, POLL_SLOT_STATS_WORLD, URL_STATS_WORLD);
+    bool batched = (p->conn_state == CONN_CONNECTED);
+    if (batched) queue_data_requests(p, req, entity_url, sizeof(entity_url));
+    http_multi_perform(p->http);
+
+    /* Responses are borrowed from the slots: the bodies stay in their
+     * receive buffers and are parsed in place */
+    http_response_t *resp = http_multi_response(p->http, POLL_SLOT_STATS_WORLD);
+    p->conn_state = connection_state_update(p->conn_state, resp->status);
+    if ((req->endpoints & ENDPOINT_STATS_WORLD) &&
+        needs_parse(p, POLL_SLOT_STATS_WORLD, resp)) {
+        char *raw = copy_body(req, resp);
+        r->snapshot = json_parse_world_stats(&p->readers[POLL_SLOT_STATS_WORLD],
+                                             resp->body.data, resp->body.size);
+        if (r->snapshot) r->snapshot->raw_json = raw;
+        else free(raw);
+        note_parsed(p, POLL_SLOT_STATS_WORLD, resp, r->snapshot != NULL);
+    }
+
+    /* Anything the batch fetched while the connection went away is ignored
+     * and overwritten by the next batch */
+    if (p->conn_state == CONN_CONNECTED) {
+        if (!batched) {
+            queue_data_requests(p, req, entity_url, sizeof(entity_url));
+            http_multi_perform(p->http);
+        }
+
+        http_response_t *qresp = http_multi_response(p->http, POLL_SLOT_QUERY);
+        if (needs_parse(p, POLL_SLOT_QUERY, qresp)) {
+            r->entity_list = json_parse_entity_list(&p->readers[POLL_SLOT_QUERY],
+                                                    qresp->body.data, qresp->body.size);
+            note_parsed(p, POLL_SLOT_QUERY, qresp, r->entity_list != NULL);
+        }
+
+        /* The detail keeps its document alive, so it parses a copy */
+        http_response_t *eresp = http_multi_response(p->http, POLL_SLOT_ENTITY);
+        if (eresp->status == 200 || eresp->status == 304) {
+            if (needs_parse(p, POLL_SLOT_ENTITY, eresp)) {
+                r->entity_detail = json_parse_entity_detail(eresp->body.data, eresp->body.size);
+                if (r->entity_detail) r->detail_path = strdup(req->entity_path);
+                note_parsed(p, POLL_SLOT_ENTITY, eresp, r->entity_detail != NULL);
+            }
+        } else if (eresp->status == 404 || eresp->status == -1) {
+            /* Entity was deleted -- the UI clears its selection */
+            r->detail_path = strdup(req->entity_path);
+            r->detail_removed = (r->detail_path != NULL);
+        }
+
+        http_response_t *cresp = http_multi_response(p->http, POLL_SLOT_COMPONENTS);
+        if (needs_parse(p, POLL_SLOT_COMPONENTS, cresp)) {
+            r->component_registry =
+                json_parse_component_registry(&p->readers[POLL_SLOT_COMPONENTS],
+                                              cresp->body.data, cresp->body.size);
+            note_parsed(p, POLL_SLOT_COMPONENTS, cresp, r->component_registry != NULL);
+        }
+
+        /* Bulk mode: list, registry and detail from one document. An entity
+         * missing from a parsed dump was deleted. */
+        http_response_t *wresp = http_multi_response(p->http, POLL_SLOT_WORLD);
+        if (needs_parse(p, POLL_SLOT_WORLD, wresp)) {
+            r->entity_list = json_parse_world(&p->readers[POLL_SLOT_WORLD],
+                                              wresp->body.data, wresp->body.size,
+                                              req->entity_path,
+                                              &r->component_registry,
+                                              &r->entity_detail);
+            if (r->entity_list && req->entity_path) {
+                r->detail_path = strdup(req->entity_path);
+                r->detail_removed = r->detail_path && !r->entity_detail;
+            }
+            note_parsed(p, POLL_SLOT_WORLD, wresp, r->entity_list != NULL);
+        }
+
+        http_response_t *presp = http_multi_response(p->http, POLL_SLOT_STATS_PIPELINE);
+        if (needs_parse(p, POLL_SLOT_STATS_PIPELINE, presp)) {
+            char *raw = copy_body(req, presp);
+            r->system_registry =
+                json_parse_pipeline_stats(&p->readers[POLL_SLOT_STATS_PIPELINE],
+                                          presp->body.data, presp->body.size);
+            if (r->system_registry) r->system_registry->raw_json = raw;
+            else free(raw);
+            note_parsed(p, POLL_SLOT_STATS_PIPELINE, presp, r->system_registry != NULL);
+        }
+    }
+
+    memcpy(r->stats, p->stats, sizeof(r->stats));
+    r->conn_state = p->conn_state;
+    r->generation = ++p->generation;
+    r->timestamp_ms = now_ms();
+    return r;
+}
+
+/* --- Thread --- */
+
+static void *poller_main(void *arg) {
+    poller_t *p = (poller_t *)arg;
+    poll_request_t req = {0};
+
+    while (atomic_load(&p->running)) {
+        /* Snapshot the request so the UI is never held up by network I/O */
+        pthread_mutex_lock(&p->lock);
+        free(req.entity_path);
+        req = p->request;
+        req.entity_path = p->request.entity_path ? strdup(p->request.entity_path) : NULL;
+        p->request_changed = false;
+        pthread_mutex_unlock(&p->lock);
+
+        /* Schedule the next cycle relative to this one's start */
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        struct itimerspec its = {0};
+        its.it_value.tv_sec  = start.tv_sec + req.interval_ms / 1000;
+        its.it_value.tv_nsec = start.tv_nsec + (long)(req.interval_ms % 1000) * 1000000L;
+        if (its.it_value.tv_nsec >= 1000000000L) {
+            its.it_value.tv_sec++;
+            its.it_value.tv_nsec -= 1000000000L;
+        }
+        timerfd_settime(p->timer_fd, TFD_TIMER_ABSTIME, &its, NULL);
+
+        poll_result_t *r = poll_cycle(p, &req);
+        if (r) publish(p, r);
+
+        /* Sleep until the timer fires, the request changes, or stop. Wakeups
+         * are sticky, so a change made mid-cycle ends this wait at once. */
+        for (;;) {
+            pthread_mutex_lock(&p->lock);
+            bool changed = p->request_changed;
+            pthread_mutex_unlock(&p->lock);
+            if (changed || !atomic_load(&p->running)) break;
+
+            if (http_multi_wait(p->http, p->timer_fd, -1)) {
+                uint64_t expirations;
+                ssize_t n = read(p->timer_fd, &expirations, sizeof(expirations));
+                (void)n;
+                break;
+            }
+        }
+    }
+
+    free(req.entity_path);
+    for (int i = 0; i < POLL_SLOT_COUNT; i++) {
+        json_reader_fini(&p->readers[i]);
+    }
+    return NULL;
+}
+
+/* --- Public API --- */
+
+bool poller_start(poller_t *p, int interval_ms) {
+    memset(p, 0, sizeof(*p));
+    atomic_init(&p->running, true);
+    atomic_init(&p->ready, NULL);
+    p->request.interval_ms = interval_ms;
+    p->conn_state = CONN_DISCONNECTED;
+
+    p->notify_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    p->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    p->http = http_multi_init(POLL_SLOT_COUNT);
+    if (p->notify_fd < 0 || p->timer_fd < 0 || !p->http) {
+        if (p->notify_fd >= 0) close(p->notify_fd);
+        if (p->timer_fd >= 0) close(p->timer_fd);
+        http_multi_fini(p->http);
+        p->http = NULL;
+        return false;
+    }
+
+    pthread_mutex_init(&p->lock, NULL);
+
+    /* Keep SIGWINCH/SIGINT etc. on the UI thread: the poller inherits a
+     * fully blocked mask, the UI thread's mask is restored afterwards. */
+    sigset_t all, prev;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &prev);
+    int rc = pthread_create(&p->thread, NULL, poller_main, p);
+    pthread_sigmask(SIG_SETMASK, &prev, NULL);
+
+    if (rc != 0) {
+        pthread_mutex_destroy(&p->lock);
+        close(p->notify_fd);
+        close(p->timer_fd);
+        http_multi_fini(p->http);
+        p->http = NULL;
+        return false;
+    }
+    p->started = true;
+    return true;
+}
+
+void poller_stop(poller_t *p) {
+    if (!p->started) return;
+
+    atomic_store(&p->running, false);
+    http_multi_wakeup(p->http);
+    pthread_join(p->thread, NULL);
+    p->started = false;
+
+    poll_result_free(atomic_exchange(&p->ready, NULL));
+    free(p->request.entity_path);
+    p->request.entity_path = NULL;
+
+    pthread_mutex_destroy(&p->lock);
+    close(p->notify_fd);
+    close(p->timer_fd);
+    http_multi_fini(p->http);
+    p->http = NULL;
+}
+
+void poller_set_request(poller_t *p, uint32_t endpoints,
+                        const char *entity_path, bool have_detail,
+                        bool keep_raw, int interval_ms) {
+    pthread_mutex_lock(&p->lock);
+
+    bool path_changed =
+        (entity_path == NULL) != (p->request.entity_path == NULL) ||
+        (entity_path && strcmp(entity_path, p->request.entity_path) != 0);
+    /* Losing the detail refetches at once; gaining it needs no new cycle */
+    bool detail_lost = p->request.have_detail && !have_detail;
+    bool changed = path_changed || detail_lost ||
+        endpoints != p->request.endpoints ||
+        keep_raw != p->request.keep_raw ||
+        interval_ms != p->request.interval_ms;
+
+    if (path_changed) {
+        free(p->request.entity_path);
+        p->request.entity_path = entity_path ? strdup(entity_path) : NULL;
+    }
+    p->request.endpoints = endpoints;
+    p->request.have_detail = have_detail;
+    p->request.keep_raw = keep_raw;
+    p->request.interval_ms = interval_ms;
+
+    if (changed) p->request_changed = true;
+    pthread_mutex_unlock(&p->lock);
+
+    if (changed) http_multi_wakeup(p->http);
+}
+
+poll_result_t *poller_take(poller_t *p) {
+    /* Drain before taking: a publish racing in after the exchange leaves
+     * the fd readable again, so it is never lost */
+    uint64_t count;
+    ssize_t n = read(p->notify_fd, &count, sizeof(count));
+    (void)n;  /* EAGAIN: nothing published since the last take */
+    return atomic_exchange(&p->ready, NULL);
+}
+
+int poller_notify_fd(const poller_t *p) {
+    return p->notify_fd;
+}
@@ -0,0 +1,141 @@
+#ifndef CELS_DEBUG_POLLER_H
+#define CELS_DEBUG_POLLER_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "data_model.h"
+#include "http_client.h"
+#include "json_parser.h"
+
+/* Background REST poller.
+ *
+ * A dedicated thread owns the curl handles and every json_parse_* call. Each
+ * poll cycle builds a fresh poll_result_t (the back buffer) and publishes it
+ * with a single atomic exchange. The UI thread picks the latest generation up
+ * with poller_take() -- it never blocks on the network and never contends on
+ * a lock to read data.
+ *
+ * If the UI has not consumed a generation by the time the next one is ready,
+ * the poller reclaims the stale one and carries over any dataset the newer
+ * cycle did not fetch, so nothing the UI asked for is dropped.
+ *
+ * Nothing here busy-waits: between cycles the poller sleeps in
+ * curl_multi_poll() on a timerfd armed for the next scheduled cycle, and is
+ * woken early through the multi handle when the request changes or on stop.
+ * Every publish bumps an eventfd the UI thread poll()s next to stdin. */
+
+/* One curl_multi slot per REST endpoint; also indexes the fetch counters */
+enum {
+    POLL_SLOT_STATS_WORLD,
+    POLL_SLOT_QUERY,
+    POLL_SLOT_ENTITY,
+    POLL_SLOT_COMPONENTS,
+    POLL_SLOT_STATS_PIPELINE,
+    POLL_SLOT_WORLD,
+    POLL_SLOT_COUNT
+};
+
+/* Cumulative per-endpoint work since start. A response whose body hashes
+ * the same as the last one parsed (or a 304 to If-None-Match) is not
+ * parsed again -- the UI keeps the structure it already has. */
+typedef struct poll_endpoint_stats {
+    uint64_t parsed;   /* responses handed to a json_parse_* function */
+    uint64_t skipped;  /* unchanged responses whose parse was skipped */
+} poll_endpoint_stats_t;
+
+/* One finished poll generation. NULL members were not fetched this cycle
+ * (or were unchanged since the last parse); non-NULL members transfer
+ * ownership to whoever consumes the result. */
+typedef struct poll_result {
+    uint64_t               generation;
+    connection_state_t     conn_state;
+    int64_t                timestamp_ms;       /* CLOCK_MONOTONIC when the cycle finished */
+
+    world_snapshot_t      *snapshot;           /* /stats/world */
+    entity_list_t         *entity_list;        /* /query (or /world) */
+    component_registry_t  *component_registry; /* /components (or /world) */
+    system_registry_t     *system_registry;    /* /stats/pipeline */
+
+    /* /entity/<path> (or /world) -- only valid for detail_path, which may
+     * no longer be the selected entity by the time the UI sees it */
+    char                  *detail_path;
+    entity_detail_t       *entity_detail;
+    bool                   detail_removed;     /* 404 or network error for detail_path */
+
+    poll_endpoint_stats_t  stats[POLL_SLOT_COUNT];  /* counters as of this cycle */
+} poll_result_t;
+
+/* What the UI currently needs. Written by the UI thread, copied by the
+ * poller at the start of each cycle.
+ *
+ * ENDPOINT_WORLD is the bulk alternative to ENDPOINT_QUERY, ENDPOINT_ENTITY
+ * and ENDPOINT_COMPONENTS: one /world dump per cycle yields the entity
+ * list, the component registry and the detail for entity_path. Request
+ * one or the other, not both. */
+typedef struct poll_request {
+    uint32_t endpoints;        /* ENDPOINT_* bitmask of the active tab */
+    char    *entity_path;      /* selected entity (slash-separated), or NULL */
+    bool     have_detail;      /* UI holds the detail for entity_path */
+    bool     keep_raw;         /* attach /stats response bodies (raw_json) */
+    int      interval_ms;      /* poll schedule */
+} poll_request_t;
+
+typedef struct poller {
+    pthread_t        thread;
+    bool             started;
+    atomic_bool      running;
+
+    /* Request hand-off (held only for copies, never across network I/O) */
+    pthread_mutex_t  lock;
+    poll_request_t   request;
+    bool             request_changed;
+
+    /* Latest finished generation, NULL once consumed */
+    _Atomic(poll_result_t *) ready;
+    int              notify_fd;  /* eventfd, readable while a result is pending */
+
+    /* Poller-thread private state */
+    http_multi_t      *http;       /* one concurrent slot per endpoint */
+    json_reader_t      readers[POLL_SLOT_COUNT];  /* pooled in-situ parsers */
+    int                timer_fd;   /* timerfd armed for the next cycle */
+    connection_state_t conn_state;
+    uint64_t           generation;
+    uint64_t           parsed_hash[POLL_SLOT_COUNT];  /* body hash of the last parse, 0 = none */
+    poll_endpoint_stats_t stats[POLL_SLOT_COUNT];
+} poller_t;
+
+/* Initialize libcurl and start the poller thread. Returns false on failure. */
+bool poller_start(poller_t *p, int interval_ms);
+
+/* Stop and join the thread, free any unconsumed result, cleanup libcurl. */
+void poller_stop(poller_t *p);
+
+/* Update what the next cycle fetches. Cheap; call once per UI loop iteration.
+ * A changed entity path wakes the poller so the inspector fills in without
+ * waiting for the next scheduled cycle. have_detail tells the poller whether
+ * an unchanged /entity response may be skipped. keep_raw attaches a copy of
+ * the /stats/world and /stats/pipeline bodies to the parsed datasets. */
+void poller_set_request(poller_t *p, uint32_t endpoints,
+                        const char *entity_path, bool have_detail,
+                        bool keep_raw, int interval_ms);
+
+/* Take ownership of the latest finished generation, or NULL if none is
+ * pending. Lock-free; caller must poll_result_free() the result.
+ * Also drains the notify fd. */
+poll_result_t *poller_take(poller_t *p);
+
+/* File descriptor that becomes readable when a new generation is ready.
+ * Add it to the UI's poll() set and call poller_take() when it fires. */
+int poller_notify_fd(const poller_t *p);
+
+/* URL the poller requests for slot: a constant, or for POLL_SLOT_ENTITY
+ * the /entity URL of entity_path formatted into buf. */
+const char *poll_slot_url(int slot, const char *entity_path, char *buf, size_t size);
+
+/* Free a result and every dataset still owned by it. */
+void poll_result_free(poll_result_t *r);
+
+#endif /* CELS_DEBUG_POLLER_H */
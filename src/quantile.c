@@ -0,0 +1,162 @@
+#define _POSIX_C_SOURCE 200809L
+#include "quantile.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* --- Log-linear buckets --- */
+
+#define QUANTILE_MAX_US ((1ull << (QUANTILE_MAX_SHIFT + QUANTILE_SUB_BITS)) - 1)
+
+static int msb64(uint64_t v) {
+    int n = 0;
+    while (v >>= 1) n++;
+    return n;
+}
+
+/* Values below 2 * HALF us map 1:1; above that, each power of two is split
+ * into HALF equal sub-buckets. */
+static int bucket_index(double ms) {
+    if (!(ms > 0.0)) return 0;    /* also catches NaN */
+    double us = ms * 1000.0 + 0.5;
+    uint64_t v = us >= (double)QUANTILE_MAX_US ? QUANTILE_MAX_US : (uint64_t)us;
+    if (v < 2 * QUANTILE_HALF) return (int)v;
+
+    int shift = msb64(v) - (QUANTILE_SUB_BITS - 1);
+    int sub = (int)(v >> shift);                  /* [HALF, 2 * HALF) */
+    return (shift + 1) * QUANTILE_HALF + (sub - QUANTILE_HALF);
+}
+
+/* Midpoint of a bucket, in ms */
+static double bucket_value(int idx) {
+    if (idx < 2 * QUANTILE_HALF) return idx / 1000.0;
+    int shift = idx / QUANTILE_HALF - 1;
+    uint64_t sub = (uint64_t)(idx % QUANTILE_HALF + QUANTILE_HALF);
+    uint64_t lo = sub << shift;
+    return (double)(lo + ((1ull << shift) >> 1)) / 1000.0;
+}
+
+static void hist_sub(quantile_hist_t *dst, const quantile_hist_t *src) {
+    if (src->total == 0) return;
+    for (int i = 0; i < QUANTILE_BUCKETS; i++) {
+        dst->counts[i] -= src->counts[i];
+    }
+    dst->total -= src->total;
+}
+
+static double hist_quantile(const quantile_hist_t *h, double q) {
+    uint64_t rank = (uint64_t)ceil(q * (double)h->total);
+    if (rank == 0) rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < QUANTILE_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= rank) return bucket_value(i);
+    }
+    return bucket_value(QUANTILE_BUCKETS - 1);
+}
+
+/* --- Sliding windows --- */
+
+static const int WINDOW_SECONDS[QUANTILE_WINDOW_COUNT] = {
+    [QUANTILE_WINDOW_10S]     = 10,
+    [QUANTILE_WINDOW_1MIN]    = QUANTILE_SLICES,
+    [QUANTILE_WINDOW_SESSION] = 0,               /* unbounded */
+};
+
+static void clear_slice(quantile_tracker_t *qt, int slot) {
+    memset(&qt->slice[slot], 0, sizeof(qt->slice[slot]));
+    qt->slice_max[slot] = 0.0;
+}
+
+/* Move the newest second forward, dropping the seconds that leave each
+ * bounded window. A jump of a whole minute or more empties them. */
+static void advance(quantile_tracker_t *qt, uint64_t to) {
+    if (to - qt->second >= QUANTILE_SLICES) {
+        for (int i = 0; i < QUANTILE_SLICES; i++) clear_slice(qt, i);
+        for (int w = 0; w < QUANTILE_WINDOW_COUNT; w++) {
+            if (WINDOW_SECONDS[w] == 0) continue;
+            memset(&qt->window[w], 0, sizeof(qt->window[w]));
+        }
+        qt->second = to;
+        return;
+    }
+
+    for (uint64_t s = qt->second + 1; s <= to; s++) {
+        for (int w = 0; w < QUANTILE_WINDOW_COUNT; w++) {
+            uint64_t span = (uint64_t)WINDOW_SECONDS[w];
+            if (span == 0 || s < span) continue;
+            hist_sub(&qt->window[w], &qt->slice[(s - span) % QUANTILE_SLICES]);
+        }
+        clear_slice(qt, (int)(s % QUANTILE_SLICES));
+    }
+    qt->second = to;
+}
+
+/* --- Public API --- */
+
+quantile_tracker_t *quantile_tracker_create(void) {
+    return calloc(1, sizeof(quantile_tracker_t));
+}
+
+void quantile_tracker_free(quantile_tracker_t *qt) {
+    free(qt);
+}
+
+void quantile_tracker_add(quantile_tracker_t *qt, uint64_t second, double value) {
+    if (isnan(value) || value < 0.0) return;
+    if (!qt->started) {
+        qt->second = second;
+        qt->started = true;
+    } else if (second > qt->second) {
+        advance(qt, second);
+    }
+
+    int idx = bucket_index(value);
+    int slot = (int)(qt->second % QUANTILE_SLICES);
+    qt->slice[slot].counts[idx]++;
+    qt->slice[slot].total++;
+    if (value > qt->slice_max[slot]) qt->slice_max[slot] = value;
+    for (int w = 0; w < QUANTILE_WINDOW_COUNT; w++) {
+        qt->window[w].counts[idx]++;
+        qt->window[w].total++;
+    }
+    if (value > qt->session_max) qt->session_max = value;
+}
+
+quantile_summary_t quantile_tracker_summary(const quantile_tracker_t *qt,
+                                            quantile_window_t window) {
+    quantile_summary_t sum = {0};
+    if (!qt) return sum;
+    const quantile_hist_t *h = &qt->window[window];
+    if (h->total == 0) return sum;
+
+    sum.count = h->total;
+    sum.p50 = hist_quantile(h, 0.50);
+    sum.p95 = hist_quantile(h, 0.95);
+    sum.p99 = hist_quantile(h, 0.99);
+
+    int span = WINDOW_SECONDS[window];
+    if (span == 0) {
+        sum.max = qt->session_max;
+    } else {
+        for (int i = 0; i < span && (uint64_t)i <= qt->second; i++) {
+            double m = qt->slice_max[(qt->second - (uint64_t)i) % QUANTILE_SLICES];
+            if (m > sum.max) sum.max = m;
+        }
+    }
+
+    /* Bucket midpoints can overshoot the largest real sample */
+    if (sum.p50 > sum.max) sum.p50 = sum.max;
+    if (sum.p95 > sum.max) sum.p95 = sum.max;
+    if (sum.p99 > sum.max) sum.p99 = sum.max;
+    return sum;
+}
+
+const char *quantile_window_name(quantile_window_t window) {
+    switch (window) {
+    case QUANTILE_WINDOW_10S:     return "10s";
+    case QUANTILE_WINDOW_1MIN:    return "1min";
+    case QUANTILE_WINDOW_SESSION: return "session";
+    default:                      return "?";
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef CELS_DEBUG_QUANTILE_H
+#define CELS_DEBUG_QUANTILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Streaming quantiles over sliding windows in constant memory.
+ *
+ * Values go into a log-linear histogram (HDR style): 64 linear sub-buckets
+ * per power of two of the value in microseconds, so every reported
+ * quantile is within ~0.8% of the true sample. Values from 0 to ~71 min
+ * are representable; larger ones land in the last bucket.
+ *
+ * Samples are tagged with the second they belong to. The tracker keeps one
+ * histogram per second for the last minute and maintains the 10 s and
+ * 1 min windows incrementally (add on insert, subtract the second that
+ * falls out), plus an all-time session histogram. Maxima are tracked
+ * exactly. Total memory is fixed at ~440 KB per tracker, so it is heap
+ * allocated. */
+
+#define QUANTILE_SUB_BITS     7
+#define QUANTILE_HALF         (1 << (QUANTILE_SUB_BITS - 1))
+#define QUANTILE_MAX_SHIFT    25    /* values up to 2^32 us */
+#define QUANTILE_BUCKETS      ((QUANTILE_MAX_SHIFT + 2) * QUANTILE_HALF)
+#define QUANTILE_SLICES       60    /* one per second of the longest window */
+
+typedef enum quantile_window {
+    QUANTILE_WINDOW_10S,
+    QUANTILE_WINDOW_1MIN,
+    QUANTILE_WINDOW_SESSION,
+    QUANTILE_WINDOW_COUNT
+} quantile_window_t;
+
+typedef struct quantile_hist {
+    uint32_t counts[QUANTILE_BUCKETS];
+    uint64_t total;
+} quantile_hist_t;
+
+typedef struct quantile_summary {
+    double   p50;
+    double   p95;
+    double   p99;
+    double   max;
+    uint64_t count;
+} quantile_summary_t;
+
+typedef struct quantile_tracker {
+    quantile_hist_t slice[QUANTILE_SLICES];     /* per second, ring by second */
+    double          slice_max[QUANTILE_SLICES];
+    quantile_hist_t window[QUANTILE_WINDOW_COUNT];
+    double          session_max;
+    uint64_t        second;                     /* newest second seen */
+    bool            started;
+} quantile_tracker_t;
+
+quantile_tracker_t *quantile_tracker_create(void);
+void quantile_tracker_free(quantile_tracker_t *qt);
+
+/* Record value (>= 0, in ms) for the given second. Seconds must not go
+ * backwards; a sample older than the newest second counts toward it. */
+void quantile_tracker_add(quantile_tracker_t *qt, uint64_t second, double value);
+
+/* p50/p95/p99/max over a window. All zero when it holds no samples. */
+quantile_summary_t quantile_tracker_summary(const quantile_tracker_t *qt,
+                                            quantile_window_t window);
+
+/* Short label for a window ("10s", "1min", "session"). */
+const char *quantile_window_name(quantile_window_t window);
+
+#endif /* CELS_DEBUG_QUANTILE_H */
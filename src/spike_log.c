@@ -0,0 +1,163 @@
+#define _POSIX_C_SOURCE 200809L
+#include "spike_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* --- Trigger --- */
+
+bool spike_trigger_parse(const char *spec, spike_trigger_t *out) {
+    if (!spec) return false;
+    if (strcmp(spec, "off") == 0) {
+        *out = (spike_trigger_t){ SPIKE_MODE_OFF, 0.0 };
+        return true;
+    }
+
+    char *end = NULL;
+    double value = strtod(spec, &end);
+    if (end == spec || !(value > 0.0)) return false;
+
+    if (*end == '\0' || strcmp(end, "ms") == 0) {
+        *out = (spike_trigger_t){ SPIKE_MODE_ABSOLUTE, value };
+        return true;
+    }
+    if (strcmp(end, "x") == 0) {
+        *out = (spike_trigger_t){ SPIKE_MODE_MEDIAN, value };
+        return true;
+    }
+    return false;
+}
+
+double spike_trigger_threshold(const spike_trigger_t *t, double median_ms) {
+    switch (t->mode) {
+    case SPIKE_MODE_ABSOLUTE: return t->value;
+    case SPIKE_MODE_MEDIAN:   return median_ms > 0.0 ? t->value * median_ms : 0.0;
+    default:                  return 0.0;
+    }
+}
+
+void spike_trigger_describe(const spike_trigger_t *t, char *buf, size_t size) {
+    switch (t->mode) {
+    case SPIKE_MODE_ABSOLUTE:
+        snprintf(buf, size, "> %.1fms", t->value);
+        break;
+    case SPIKE_MODE_MEDIAN:
+        snprintf(buf, size, "> %.1fx median", t->value);
+        break;
+    default:
+        snprintf(buf, size, "off");
+        break;
+    }
+}
+
+/* --- Log --- */
+
+static void record_clear(spike_record_t *rec) {
+    world_snapshot_free(rec->snapshot);
+    system_registry_free(rec->systems);
+    memset(rec, 0, sizeof(*rec));
+}
+
+void spike_log_fini(spike_log_t *log) {
+    for (int i = 0; i < SPIKE_LOG_CAPACITY; i++) {
+        record_clear(&log->records[i]);
+    }
+    log->head = 0;
+    log->count = 0;
+}
+
+const spike_record_t *spike_log_capture(spike_log_t *log, uint64_t seq,
+                                        int64_t now_ms, double frame_time_ms,
+                                        double threshold_ms, double median_ms,
+                                        const world_snapshot_t *snapshot,
+                                        const system_registry_t *systems) {
+    spike_record_t *rec = &log->records[log->head];
+    record_clear(rec);
+
+    rec->id = ++log->fired;
+    rec->seq = seq;
+    rec->timestamp_ms = now_ms;
+    rec->frame_time_ms = frame_time_ms;
+    rec->threshold_ms = threshold_ms;
+    rec->median_ms = median_ms;
+    /* A failed copy leaves the member NULL; the timing is still worth keeping */
+    rec->snapshot = world_snapshot_clone(snapshot);
+    rec->systems = system_registry_clone(systems);
+
+    log->head = (log->head + 1) % SPIKE_LOG_CAPACITY;
+    if (log->count < SPIKE_LOG_CAPACITY) log->count++;
+    return rec;
+}
+
+const spike_record_t *spike_log_get(const spike_log_t *log, int i) {
+    if (i < 0 || i >= log->count) return NULL;
+    int slot = (log->head - 1 - i + 2 * SPIKE_LOG_CAPACITY) % SPIKE_LOG_CAPACITY;
+    return &log->records[slot];
+}
+
+/* --- Export --- */
+
+static void write_json_string(FILE *f, const char *s) {
+    if (!s) {
+        fputs("null", f);
+        return;
+    }
+    fputc('"', f);
+    for (const unsigned char *p = (const unsigned char *)s; *p; p++) {
+        switch (*p) {
+        case '"':  fputs("\\\"", f); break;
+        case '\\': fputs("\\\\", f); break;
+        case '\n': fputs("\\n", f);  break;
+        case '\t': fputs("\\t", f);  break;
+        default:
+            if (*p < 0x20) fprintf(f, "\\u%04x", *p);
+            else fputc(*p, f);
+        }
+    }
+    fputc('"', f);
+}
+
+bool spike_log_save(const spike_record_t *rec, const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) return false;
+
+    fprintf(f, "{\n  \"id\": %llu,\n  \"seq\": %llu,\n",
+            (unsigned long long)rec->id, (unsigned long long)rec->seq);
+    fprintf(f, "  \"frame_time_ms\": %.6f,\n  \"threshold_ms\": %.6f,\n"
+               "  \"median_ms\": %.6f,\n",
+            rec->frame_time_ms, rec->threshold_ms, rec->median_ms);
+
+    const world_snapshot_t *snap = rec->snapshot;
+    if (snap) {
+        fprintf(f, "  \"world\": {\"entity_count\": %.0f, \"fps\": %.3f, "
+                   "\"frame_time_ms\": %.6f, \"system_count\": %.0f},\n",
+                snap->entity_count, snap->fps, snap->frame_time_ms, snap->system_count);
+    } else {
+        fputs("  \"world\": null,\n", f);
+    }
+
+    const system_registry_t *reg = rec->systems;
+    fputs("  \"systems\": [", f);
+    for (int i = 0; reg && i < reg->count; i++) {
+        const system_info_t *si = &reg->systems[i];
+        fputs(i == 0 ? "\n    {\"name\": " : ",\n    {\"name\": ", f);
+        write_json_string(f, si->full_path ? si->full_path : si->name);
+        fputs(", \"phase\": ", f);
+        write_json_string(f, si->phase);
+        fprintf(f, ", \"disabled\": %s, \"time_spent_ms\": %.6f, "
+                   "\"matched_entity_count\": %d, \"matched_table_count\": %d}",
+                si->disabled ? "true" : "false", si->time_spent_ms,
+                si->matched_entity_count, si->matched_table_count);
+    }
+    fputs(reg && reg->count > 0 ? "\n  ],\n" : "],\n", f);
+
+    /* Raw responses are JSON already -- embed them verbatim */
+    fprintf(f, "  \"stats_world\": %s,\n",
+            snap && snap->raw_json ? snap->raw_json : "null");
+    fprintf(f, "  \"stats_pipeline\": %s\n}\n",
+            reg && reg->raw_json ? reg->raw_json : "null");
+
+    bool ok = !ferror(f);
+    if (fclose(f) != 0) ok = false;
+    return ok;
+}
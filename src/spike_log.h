@@ -0,0 +1,79 @@
+#ifndef CELS_DEBUG_SPIKE_LOG_H
+#define CELS_DEBUG_SPIKE_LOG_H
+
+#include "data_model.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Frame-spike capture.
+ *
+ * A trigger is checked against every frame-time sample the world history
+ * ingests. When one crosses the threshold, the current world snapshot and
+ * system registry -- including the raw /stats JSON they were parsed from --
+ * are deep-copied into the spike log, so the per-system numbers around a
+ * one-off hitch survive later polls. The log keeps the newest
+ * SPIKE_LOG_CAPACITY spikes. Owned by the UI thread. */
+
+#define SPIKE_LOG_CAPACITY      32
+#define SPIKE_MEDIAN_MIN_SAMPLES 60   /* median mode waits for 1 s of data */
+
+typedef enum spike_mode {
+    SPIKE_MODE_OFF,
+    SPIKE_MODE_ABSOLUTE,   /* value: frame time in ms */
+    SPIKE_MODE_MEDIAN,     /* value: multiple of the rolling median */
+} spike_mode_t;
+
+typedef struct spike_trigger {
+    spike_mode_t mode;
+    double       value;
+} spike_trigger_t;
+
+typedef struct spike_record {
+    uint64_t           id;              /* 1-based, counts every capture */
+    uint64_t           seq;             /* world history sample that fired */
+    int64_t            timestamp_ms;    /* CLOCK_MONOTONIC at capture */
+    double             frame_time_ms;
+    double             threshold_ms;
+    double             median_ms;       /* rolling median at the time (0 = unknown) */
+    world_snapshot_t  *snapshot;        /* frozen copies, owned */
+    system_registry_t *systems;
+} spike_record_t;
+
+typedef struct spike_log {
+    spike_trigger_t trigger;
+    spike_record_t  records[SPIKE_LOG_CAPACITY];  /* ring, oldest evicted */
+    int             head;                         /* next slot to write */
+    int             count;
+    uint64_t        fired;                        /* captures since start */
+} spike_log_t;
+
+/* Parse "off", "<ms>ms" (absolute) or "<n>x" (times the median).
+ * Returns false on malformed input, leaving *out untouched. */
+bool spike_trigger_parse(const char *spec, spike_trigger_t *out);
+
+/* Threshold in ms for the given median, or 0 if the trigger is not armed
+ * (off, or median mode without a median yet). */
+double spike_trigger_threshold(const spike_trigger_t *t, double median_ms);
+
+/* Human-readable trigger, e.g. "> 33.0ms" or "> 3.0x median". */
+void spike_trigger_describe(const spike_trigger_t *t, char *buf, size_t size);
+
+void spike_log_fini(spike_log_t *log);
+
+/* Record a spike, freezing copies of snapshot and systems (either may be
+ * NULL). Evicts the oldest record when full. Returns the new record. */
+const spike_record_t *spike_log_capture(spike_log_t *log, uint64_t seq,
+                                        int64_t now_ms, double frame_time_ms,
+                                        double threshold_ms, double median_ms,
+                                        const world_snapshot_t *snapshot,
+                                        const system_registry_t *systems);
+
+/* i-th record, newest first (0 = most recent), or NULL past the end. */
+const spike_record_t *spike_log_get(const spike_log_t *log, int i);
+
+/* Write a record as JSON (summary, frozen systems, raw stats responses).
+ * Returns false if the file could not be written. */
+bool spike_log_save(const spike_record_t *rec, const char *path);
+
+#endif /* CELS_DEBUG_SPIKE_LOG_H */
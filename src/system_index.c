@@ -0,0 +1,73 @@
+#define _POSIX_C_SOURCE 200809L
+#include "system_index.h"
+#include <stdlib.h>
+#include <string.h>
+
+void system_index_fini(system_index_t *idx) {
+    free(idx->entity_of);
+    u64_map_fini(&idx->by_entity);
+    memset(idx, 0, sizeof(*idx));
+}
+
+/* Entity for a stats path ("a.b.c" -> "a/b/c") */
+static entity_node_t *find_by_stats_path(const entity_list_t *list, const char *path) {
+    if (!path) return NULL;
+    char stack[256];
+    size_t len = strlen(path);
+    char *slashed = len < sizeof(stack) ? stack : malloc(len + 1);
+    if (!slashed) return NULL;
+    for (size_t i = 0; i <= len; i++) {
+        slashed[i] = path[i] == '.' ? '/' : path[i];
+    }
+    entity_node_t *node = entity_list_find_by_path(list, slashed);
+    if (slashed != stack) free(slashed);
+    return node;
+}
+
+void system_index_rebuild(system_index_t *idx, const entity_list_t *list,
+                          const system_registry_t *reg) {
+    system_index_fini(idx);
+    if (!reg || reg->count == 0) return;
+
+    idx->entity_of = calloc((size_t)reg->count, sizeof(*idx->entity_of));
+    if (!idx->entity_of ||
+        !u64_map_init(&idx->by_entity, (size_t)reg->count)) {
+        system_index_fini(idx);
+        return;
+    }
+    idx->count = reg->count;
+    if (!list) return;
+
+    /* Leaf-name fallback for stats paths that do not resolve */
+    str_map_t roots = {0};
+    if (!str_map_init(&roots, (size_t)list->root_count)) return;
+    for (int i = 0; i < list->root_count; i++) {
+        entity_node_t *node = list->roots[i];
+        if (node->name && !str_map_get(&roots, node->name, strlen(node->name))) {
+            str_map_put(&roots, node->name, strlen(node->name), node);
+        }
+    }
+
+    for (int s = 0; s < reg->count; s++) {
+        system_info_t *si = &reg->systems[s];
+        entity_node_t *node = find_by_stats_path(list, si->full_path);
+        if (!node && si->name) node = str_map_get(&roots, si->name, strlen(si->name));
+        if (!node) continue;
+        idx->entity_of[s] = node;
+        if (!u64_map_get(&idx->by_entity, node->id)) {
+            u64_map_put(&idx->by_entity, node->id, si);
+        }
+    }
+    str_map_fini(&roots);
+}
+
+entity_node_t *system_index_entity(const system_index_t *idx, int i) {
+    if (i < 0 || i >= idx->count) return NULL;
+    return idx->entity_of[i];
+}
+
+system_info_t *system_index_for_entity(const system_index_t *idx,
+                                       const entity_node_t *node) {
+    if (!node) return NULL;
+    return u64_map_get(&idx->by_entity, node->id);
+}
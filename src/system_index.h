@@ -0,0 +1,35 @@
+#ifndef CELS_DEBUG_SYSTEM_INDEX_H
+#define CELS_DEBUG_SYSTEM_INDEX_H
+
+#include "data_model.h"
+#include "hash_map.h"
+
+/* Cross-reference between the pipeline stats' systems and the entity
+ * nodes that represent them.
+ *
+ * A system is matched to its entity by path (the stats report the
+ * dot-separated path, entities use slashes), falling back to the first
+ * root entity with the same leaf name. Rebuilt by the main loop whenever
+ * the entity list or system registry is replaced, so every tab does O(1)
+ * lookups instead of scanning one dataset per item of the other. Keys and
+ * values are borrowed from those two datasets. */
+
+typedef struct system_index {
+    entity_node_t **entity_of;  /* per registry system, NULL if unmatched */
+    int             count;      /* registry systems indexed */
+    u64_map_t       by_entity;  /* entity id -> system_info_t* */
+} system_index_t;
+
+/* Rebuild against the current datasets (either may be NULL). */
+void system_index_rebuild(system_index_t *idx, const entity_list_t *list,
+                          const system_registry_t *reg);
+void system_index_fini(system_index_t *idx);
+
+/* Entity of the i-th registry system, or NULL. */
+entity_node_t *system_index_entity(const system_index_t *idx, int i);
+
+/* Pipeline stats for a system entity, or NULL. */
+system_info_t *system_index_for_entity(const system_index_t *idx,
+                                       const entity_node_t *node);
+
+#endif /* CELS_DEBUG_SYSTEM_INDEX_H */
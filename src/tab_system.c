@@ -4,24 +4,32 @@
 #include "tabs/tab_systems.h"
 #include "tabs/tab_performance.h"
 #include "tabs/tab_tests.h"
+#include "tabs/tab_archetypes.h"
+#include "tabs/tab_memory.h"
 
 /* Tab definitions (static, const) */
 static const tab_def_t tab_defs[TAB_COUNT] = {
-    { "Overview",     ENDPOINT_STATS_WORLD | ENDPOINT_QUERY,
+    { "Overview",     ENDPOINT_STATS_WORLD | ENDPOINT_QUERY | ENDPOINT_POLL_STATS,
       tab_overview_init, tab_overview_fini,
-      tab_overview_draw, tab_overview_input },
+      tab_overview_draw, tab_overview_input, NULL },
     { "CELS",         ENDPOINT_QUERY | ENDPOINT_ENTITY | ENDPOINT_COMPONENTS,
       tab_cels_init, tab_cels_fini,
-      tab_cels_draw, tab_cels_input },
+      tab_cels_draw, tab_cels_input, tab_cels_redraw_deadline },
     { "Systems",      ENDPOINT_QUERY | ENDPOINT_ENTITY | ENDPOINT_STATS_PIPELINE,
       tab_systems_init, tab_systems_fini,
-      tab_systems_draw, tab_systems_input },
+      tab_systems_draw, tab_systems_input, NULL },
     { "Performance",  ENDPOINT_STATS_WORLD | ENDPOINT_STATS_PIPELINE | ENDPOINT_QUERY,
       tab_performance_init, tab_performance_fini,
-      tab_performance_draw, tab_performance_input },
+      tab_performance_draw, tab_performance_input, NULL },
     { "Tests",        ENDPOINT_NONE,
       tab_tests_init, tab_tests_fini,
-      tab_tests_draw, tab_tests_input },
+      tab_tests_draw, tab_tests_input, NULL },
+    { "Archetypes",   ENDPOINT_QUERY | ENDPOINT_COMPONENTS,
+      tab_archetypes_init, tab_archetypes_fini,
+      tab_archetypes_draw, tab_archetypes_input, NULL },
+    { "Memory",       ENDPOINT_COMPONENTS,
+      tab_memory_init, tab_memory_fini,
+      tab_memory_draw, tab_memory_input, NULL },
 };
 
 void tab_system_init(tab_system_t *ts) {
@@ -29,6 +37,7 @@ void tab_system_init(tab_system_t *ts) {
     for (int i = 0; i < TAB_COUNT; i++) {
         ts->tabs[i].def = &tab_defs[i];
         ts->tabs[i].state = NULL;
+        ts->tabs[i].dirty = true;
         if (ts->tabs[i].def->init) {
             ts->tabs[i].def->init(&ts->tabs[i]);
         }
@@ -46,29 +55,55 @@ void tab_system_fini(tab_system_t *ts) {
 void tab_system_activate(tab_system_t *ts, int index) {
     if (index >= 0 && index < TAB_COUNT) {
         ts->active = index;
+        ts->tabs[index].dirty = true;
     }
 }
 
 void tab_system_next(tab_system_t *ts) {
-    ts->active = (ts->active + 1) % TAB_COUNT;
+    tab_system_activate(ts, (ts->active + 1) % TAB_COUNT);
 }
 
 bool tab_system_handle_input(tab_system_t *ts, int ch, void *app_state) {
     tab_t *active = &ts->tabs[ts->active];
+    active->dirty = true;
     if (active->def->handle_input) {
         return active->def->handle_input(active, ch, app_state);
     }
     return false;
 }
 
-void tab_system_draw(const tab_system_t *ts, WINDOW *win,
+void tab_system_draw(tab_system_t *ts, WINDOW *win,
                      const void *app_state) {
-    const tab_t *active = &ts->tabs[ts->active];
+    tab_t *active = &ts->tabs[ts->active];
+    active->dirty = false;
     if (active->def->draw) {
         active->def->draw(active, win, app_state);
     }
 }
 
+void tab_system_mark_dirty(tab_system_t *ts, uint32_t changed_endpoints) {
+    for (int i = 0; i < TAB_COUNT; i++) {
+        if (ts->tabs[i].def->required_endpoints & changed_endpoints) {
+            ts->tabs[i].dirty = true;
+        }
+    }
+}
+
+void tab_system_mark_all_dirty(tab_system_t *ts) {
+    for (int i = 0; i < TAB_COUNT; i++) {
+        ts->tabs[i].dirty = true;
+    }
+}
+
+bool tab_system_needs_draw(const tab_system_t *ts) {
+    return ts->tabs[ts->active].dirty;
+}
+
+int64_t tab_system_redraw_deadline(const tab_system_t *ts) {
+    const tab_t *active = &ts->tabs[ts->active];
+    return active->def->redraw_deadline ? active->def->redraw_deadline(active) : 0;
+}
+
 uint32_t tab_system_required_endpoints(const tab_system_t *ts) {
     return ts->tabs[ts->active].def->required_endpoints;
 }
@@ -19,6 +19,7 @@ typedef enum {
     ENDPOINT_ENTITY         = (1u << 3),  /* /entity/<path> */
     ENDPOINT_COMPONENTS     = (1u << 4),  /* /components */
     ENDPOINT_WORLD          = (1u << 5),  /* /world */
+    ENDPOINT_POLL_STATS     = (1u << 6),  /* poller counters (not fetched) */
 } endpoint_t;
 
 /* Tab function signatures -- void* for app_state avoids circular includes */
@@ -27,6 +28,10 @@ typedef void (*tab_fini_fn)(tab_t *self);
 typedef void (*tab_draw_fn)(const tab_t *self, WINDOW *win,
                             const void *app_state);
 typedef bool (*tab_handle_input_fn)(tab_t *self, int ch, void *app_state);
+/* CLOCK_MONOTONIC ms at which the tab needs a timed redraw (e.g. the end of
+ * a highlight), 0 for none. Read by the main loop; a tab forgets a passed
+ * deadline when it next draws. */
+typedef int64_t (*tab_deadline_fn)(const tab_t *self);
 
 /* Tab definition (vtable + metadata) -- one per tab TYPE, shared const */
 struct tab_def {
@@ -36,20 +41,22 @@ struct tab_def {
     tab_fini_fn       fini;
     tab_draw_fn       draw;
     tab_handle_input_fn handle_input;
+    tab_deadline_fn   redraw_deadline;   /* NULL = never needs one */
 };
 
 /* Tab instance (vtable pointer + per-tab state) -- one per tab slot */
 struct tab_t {
     const tab_def_t  *def;
     void             *state;   /* per-tab private data */
+    bool              dirty;   /* needs a redraw on next render */
 };
 
 /* Tab system (owns the tab array) */
-#define TAB_COUNT 5
+#define TAB_COUNT 7
 
 struct tab_system {
     tab_t tabs[TAB_COUNT];
-    int   active;              /* index of currently active tab [0..4] */
+    int   active;              /* index of currently active tab [0..6] */
 };
 
 /* Lifecycle */
@@ -60,11 +67,21 @@ void tab_system_fini(tab_system_t *ts);
 void tab_system_activate(tab_system_t *ts, int index);
 void tab_system_next(tab_system_t *ts);
 
-/* Dispatch */
+/* Dispatch. Input marks the active tab dirty; draw clears its flag. */
 bool tab_system_handle_input(tab_system_t *ts, int ch, void *app_state);
-void tab_system_draw(const tab_system_t *ts, WINDOW *win,
+void tab_system_draw(tab_system_t *ts, WINDOW *win,
                      const void *app_state);
 
+/* Dirty tracking -- a tab is only redrawn when marked dirty.
+ * mark_dirty flags every tab whose required endpoints intersect the
+ * ENDPOINT_* mask of datasets that changed; mark_all_dirty is for resize. */
+void tab_system_mark_dirty(tab_system_t *ts, uint32_t changed_endpoints);
+void tab_system_mark_all_dirty(tab_system_t *ts);
+bool tab_system_needs_draw(const tab_system_t *ts);
+
+/* Timed redraw the active tab asks for (see tab_deadline_fn), 0 = none */
+int64_t tab_system_redraw_deadline(const tab_system_t *ts);
+
 /* Smart polling */
 uint32_t tab_system_required_endpoints(const tab_system_t *ts);
 
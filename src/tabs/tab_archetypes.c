@@ -0,0 +1,462 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "tab_archetypes.h"
+#include "../tui.h"
+#include "../split_panel.h"
+#include "../scroll.h"
+#include "../widgets.h"
+#include "../data_model.h"
+#include <ncurses.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Archetype browser: entities grouped by identical component/tag set
+ * (entity_list_build_archetypes), one row per archetype with its entity
+ * count, estimated row size and signature. Fragmentation is measured by
+ * neighbors -- archetypes one component or tag away, i.e. the tables an
+ * add/remove of a single id moves entities between. Many small archetypes
+ * with many neighbors is what archetype explosion looks like. */
+
+typedef enum {
+    ARCH_SORT_ENTITIES,     /* most entities first */
+    ARCH_SORT_SIZE,         /* largest estimated row first */
+    ARCH_SORT_FRAGMENTATION,/* most neighbors first, then fewest entities */
+    ARCH_SORT_KEY_COUNT
+} arch_sort_t;
+
+static const char *SORT_NAMES[ARCH_SORT_KEY_COUNT] = {
+    "count", "size", "fragmentation",
+};
+
+/* Per-tab private state */
+typedef struct archetypes_state {
+    split_panel_t panel;
+    scroll_state_t scroll;
+    bool panel_created;
+    arch_sort_t sort;
+
+    /* Archetype indices in display order */
+    int *order;
+    int order_count;
+    int order_capacity;
+
+    /* Inputs the order was built from */
+    uint64_t seen_list_gen;
+    uint64_t seen_registry_gen;
+    arch_sort_t seen_sort;
+    bool built;
+} archetypes_state_t;
+
+/* --- Sorting --- */
+
+static const archetype_t *sort_base;   /* qsort has no context argument */
+
+static int cmp_count(const void *a, const void *b) {
+    const archetype_t *x = &sort_base[*(const int *)a];
+    const archetype_t *y = &sort_base[*(const int *)b];
+    if (x->entity_count != y->entity_count) return y->entity_count - x->entity_count;
+    return *(const int *)a - *(const int *)b;
+}
+
+static int cmp_size(const void *a, const void *b) {
+    const archetype_t *x = &sort_base[*(const int *)a];
+    const archetype_t *y = &sort_base[*(const int *)b];
+    if (x->row_size != y->row_size) return y->row_size - x->row_size;
+    return cmp_count(a, b);
+}
+
+static int cmp_fragmentation(const void *a, const void *b) {
+    const archetype_t *x = &sort_base[*(const int *)a];
+    const archetype_t *y = &sort_base[*(const int *)b];
+    if (x->neighbor_count != y->neighbor_count) return y->neighbor_count - x->neighbor_count;
+    if (x->entity_count != y->entity_count) return x->entity_count - y->entity_count;
+    return *(const int *)a - *(const int *)b;
+}
+
+static void rebuild_order(archetypes_state_t *as, const entity_list_t *list) {
+    as->order_count = 0;
+    if (!list || list->archetype_count == 0) return;
+
+    if (list->archetype_count > as->order_capacity) {
+        int *grown = realloc(as->order, (size_t)list->archetype_count * sizeof(int));
+        if (!grown) return;
+        as->order = grown;
+        as->order_capacity = list->archetype_count;
+    }
+    for (int i = 0; i < list->archetype_count; i++) as->order[i] = i;
+    as->order_count = list->archetype_count;
+
+    static int (*const CMP[ARCH_SORT_KEY_COUNT])(const void *, const void *) = {
+        cmp_count, cmp_size, cmp_fragmentation,
+    };
+    sort_base = list->archetypes;
+    qsort(as->order, (size_t)as->order_count, sizeof(int), CMP[as->sort]);
+    sort_base = NULL;
+}
+
+/* --- Formatting --- */
+
+/* Last segment of a dotted name ("flecs.core.Identifier" -> "Identifier") */
+static const char *short_name(intern_id_t id) {
+    const char *name = intern_str(id);
+    if (!name) return "?";
+    const char *dot = strrchr(name, '.');
+    return dot && dot[1] ? dot + 1 : name;
+}
+
+/* Row size, prefixed with '~' when some components have no known size */
+static void format_row_size(const archetype_t *a, char *buf, size_t size) {
+    char num[16];
+    format_bytes(a->row_size, num, sizeof(num));
+    snprintf(buf, size, "%s%s", a->unsized_count > 0 ? "~" : "", num);
+}
+
+/* Signature as "A, B, #Tag", cut at width */
+static void print_signature(WINDOW *w, int row, int col, int width,
+                            const archetype_t *a) {
+    int total = a->component_count + a->tag_count;
+    wmove(w, row, col);
+    if (total == 0) {
+        wattron(w, A_DIM);
+        wprintw(w, "%.*s", width, "(empty)");
+        wattroff(w, A_DIM);
+        return;
+    }
+    int used = 0;
+    for (int i = 0; i < total && used < width; i++) {
+        bool is_tag = i >= a->component_count;
+        char item[128];
+        int n = snprintf(item, sizeof(item), "%s%s%s", i > 0 ? ", " : "",
+                         is_tag ? "#" : "", short_name(a->ids[i]));
+        if (n < 0) break;
+        if (is_tag) wattron(w, A_DIM);
+        wprintw(w, "%.*s", width - used, item);
+        if (is_tag) wattroff(w, A_DIM);
+        used += n;
+    }
+}
+
+/* --- Right panel --- */
+
+/* Label in the key column; the cursor is left at the value column */
+static void draw_key(WINDOW *w, int row, const char *key) {
+    wattron(w, COLOR_PAIR(CP_JSON_KEY));
+    mvwprintw(w, row, 2, "%s", key);
+    wattroff(w, COLOR_PAIR(CP_JSON_KEY));
+    wmove(w, row, 18);
+}
+
+static int draw_section(WINDOW *w, int row, int rw, const char *title) {
+    wattron(w, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
+    mvwprintw(w, row, 1, "%.*s", rw, title);
+    wattroff(w, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
+    return row + 1;
+}
+
+static int draw_summary(WINDOW *w, int row, int rw, const entity_list_t *list) {
+    int singletons = 0, edges = 0;
+    double bytes = 0.0;
+    for (int i = 0; i < list->archetype_count; i++) {
+        const archetype_t *a = &list->archetypes[i];
+        if (a->entity_count == 1) singletons++;
+        edges += a->neighbor_count;
+        bytes += (double)a->row_size * a->entity_count;
+    }
+    edges /= 2;   /* every edge was counted at both ends */
+
+    row = draw_section(w, row, rw, "World");
+    draw_key(w, row++, "Archetypes");
+    wattron(w, COLOR_PAIR(CP_JSON_NUMBER));
+    wprintw(w, "%d", list->archetype_count);
+    wattroff(w, COLOR_PAIR(CP_JSON_NUMBER));
+
+    draw_key(w, row++, "Entities");
+    wattron(w, COLOR_PAIR(CP_JSON_NUMBER));
+    wprintw(w, "%d", list->count);
+    wattroff(w, COLOR_PAIR(CP_JSON_NUMBER));
+    if (list->archetype_count > 0) {
+        wprintw(w, "  (%.1f per archetype)",
+                (double)list->count / list->archetype_count);
+    }
+
+    draw_key(w, row++, "Singletons");
+    wattron(w, COLOR_PAIR(singletons * 2 > list->archetype_count
+                          ? CP_RECONNECTING : CP_JSON_NUMBER));
+    wprintw(w, "%d", singletons);
+    wattroff(w, COLOR_PAIR(singletons * 2 > list->archetype_count
+                           ? CP_RECONNECTING : CP_JSON_NUMBER));
+    if (list->archetype_count > 0) {
+        wprintw(w, "  (%.0f%% of archetypes)",
+                100.0 * singletons / list->archetype_count);
+    }
+
+    draw_key(w, row++, "One-id edges");
+    wattron(w, COLOR_PAIR(CP_JSON_NUMBER));
+    wprintw(w, "%d", edges);
+    wattroff(w, COLOR_PAIR(CP_JSON_NUMBER));
+
+    char buf[32];
+    format_bytes(bytes, buf, sizeof(buf));
+    draw_key(w, row++, "Est. row data");
+    wattron(w, COLOR_PAIR(CP_JSON_NUMBER));
+    wprintw(w, "%s", buf);
+    wattroff(w, COLOR_PAIR(CP_JSON_NUMBER));
+    return row + 1;
+}
+
+static void draw_archetype(WINDOW *w, int row, int rh, int rw,
+                           const entity_list_t *list, int index) {
+    const archetype_t *a = &list->archetypes[index];
+    char buf[64];
+    int last = rh;   /* last usable row (inside the border) */
+
+    snprintf(buf, sizeof(buf), "Archetype %d", index + 1);
+    row = draw_section(w, row, rw, buf);
+
+    draw_key(w, row++, "Entities");
+    wattron(w, COLOR_PAIR(CP_JSON_NUMBER));
+    wprintw(w, "%d", a->entity_count);
+    wattroff(w, COLOR_PAIR(CP_JSON_NUMBER));
+
+    format_row_size(a, buf, sizeof(buf));
+    draw_key(w, row++, "Row size");
+    wattron(w, COLOR_PAIR(CP_JSON_NUMBER));
+    wprintw(w, "%s", buf);
+    wattroff(w, COLOR_PAIR(CP_JSON_NUMBER));
+    if (a->unsized_count > 0) {
+        wattron(w, A_DIM);
+        wprintw(w, "  (%d without size)", a->unsized_count);
+        wattroff(w, A_DIM);
+    }
+
+    draw_key(w, row++, "Neighbors");
+    wattron(w, COLOR_PAIR(CP_JSON_NUMBER));
+    wprintw(w, "%d", a->neighbor_count);
+    wattroff(w, COLOR_PAIR(CP_JSON_NUMBER));
+    row++;
+
+    /* Signature with per-component sizes */
+    if (row <= last) row = draw_section(w, row, rw, "Signature");
+    for (int i = 0; i < a->component_count + a->tag_count && row <= last; i++) {
+        bool is_tag = i >= a->component_count;
+        const char *name = intern_str(a->ids[i]);
+        if (is_tag) wattron(w, A_DIM);
+        mvwprintw(w, row, 2, "%s%.*s", is_tag ? "#" : "", rw - 12, name ? name : "?");
+        if (is_tag) wattroff(w, A_DIM);
+        if (!is_tag) {
+            int size = a->component_sizes[i];
+            if (size >= 0) {
+                wattron(w, COLOR_PAIR(CP_JSON_NUMBER));
+                mvwprintw(w, row, rw - 8, "%7dB", size);
+                wattroff(w, COLOR_PAIR(CP_JSON_NUMBER));
+            } else {
+                wattron(w, A_DIM);
+                mvwprintw(w, row, rw - 8, "%8s", "?");
+                wattroff(w, A_DIM);
+            }
+        }
+        row++;
+    }
+    row++;
+
+    /* Archetypes an add/remove of one id away */
+    if (a->neighbor_count > 0 && row <= last) {
+        row = draw_section(w, row, rw, "One id away");
+        for (int n = 0; n < a->neighbor_count && row <= last; n++) {
+            const archetype_edge_t *e = &a->neighbors[n];
+            const archetype_t *b = &list->archetypes[e->archetype];
+            const char *name = intern_str(e->id);
+            wattron(w, COLOR_PAIR(e->added ? CP_CONNECTED : CP_DISCONNECTED));
+            mvwprintw(w, row, 2, "%c%s%.*s", e->added ? '+' : '-', e->is_tag ? "#" : "",
+                      rw - 20, name ? name : "?");
+            wattroff(w, COLOR_PAIR(e->added ? CP_CONNECTED : CP_DISCONNECTED));
+            wprintw(w, "  %d ent%s", b->entity_count, b->entity_count == 1 ? "" : "s");
+            row++;
+        }
+        row++;
+    }
+
+    /* Members, as many as fit */
+    if (row <= last) row = draw_section(w, row, rw, "Entities");
+    for (int i = 0; i < a->entity_count && row <= last; i++) {
+        if (row == last && i < a->entity_count - 1) {
+            wattron(w, A_DIM);
+            mvwprintw(w, row, 2, "... %d more", a->entity_count - i);
+            wattroff(w, A_DIM);
+            break;
+        }
+        const entity_node_t *node = a->entities[i];
+        wattron(w, COLOR_PAIR(CP_ENTITY_NAME));
+        if (node->name) {
+            mvwprintw(w, row, 2, "%.*s", rw - 2, node->full_path ? node->full_path : node->name);
+        } else {
+            mvwprintw(w, row, 2, "#%llu", (unsigned long long)node->id);
+        }
+        wattroff(w, COLOR_PAIR(CP_ENTITY_NAME));
+        row++;
+    }
+}
+
+/* --- Lifecycle --- */
+
+void tab_archetypes_init(tab_t *self) {
+    archetypes_state_t *as = calloc(1, sizeof(archetypes_state_t));
+    if (!as) return;
+    scroll_reset(&as->scroll);
+    as->sort = ARCH_SORT_ENTITIES;
+    self->state = as;
+}
+
+void tab_archetypes_fini(tab_t *self) {
+    archetypes_state_t *as = (archetypes_state_t *)self->state;
+    if (!as) return;
+    if (as->panel_created) {
+        split_panel_destroy(&as->panel);
+    }
+    free(as->order);
+    free(as);
+    self->state = NULL;
+}
+
+/* --- Draw --- */
+
+void tab_archetypes_draw(const tab_t *self, WINDOW *win, const void *app_state) {
+    archetypes_state_t *as = (archetypes_state_t *)self->state;
+    if (!as) return;
+
+    const app_state_t *state = (const app_state_t *)app_state;
+    const entity_list_t *list = state->entity_list;
+
+    int h = getmaxy(win);
+    int w = getmaxx(win);
+
+    if (!as->panel_created) {
+        split_panel_create(&as->panel, h, w, getbegy(win));
+        as->panel_created = true;
+    } else if (h != as->panel.height ||
+               w != as->panel.left_width + as->panel.right_width) {
+        split_panel_resize(&as->panel, h, w, getbegy(win));
+    }
+
+    /* Row sizes come from the registry, so a new one can reorder by size */
+    if (!as->built || as->seen_list_gen != state->entity_list_gen ||
+        as->seen_registry_gen != state->component_registry_gen ||
+        as->seen_sort != as->sort) {
+        rebuild_order(as, list);
+        as->seen_list_gen = state->entity_list_gen;
+        as->seen_registry_gen = state->component_registry_gen;
+        as->seen_sort = as->sort;
+        as->built = true;
+    }
+
+    werase(as->panel.left);
+    werase(as->panel.right);
+
+    char left_title[64];
+    snprintf(left_title, sizeof(left_title), "Archetypes (%d) by %s",
+             as->order_count, SORT_NAMES[as->sort]);
+    split_panel_draw_borders(&as->panel, left_title, "Detail");
+
+    WINDOW *lwin = as->panel.left;
+    int lh = getmaxy(lwin) - 2;
+    int lw = getmaxx(lwin) - 2;
+
+    if (as->order_count > 0) {
+        /* Column header, then one row per archetype */
+        wattron(lwin, COLOR_PAIR(CP_LABEL));
+        mvwprintw(lwin, 1, 1, "%7s %7s %4s  %s", "Ents", "Row", "Near", "Signature");
+        wattroff(lwin, COLOR_PAIR(CP_LABEL));
+
+        as->scroll.total_items = as->order_count;
+        as->scroll.visible_rows = lh - 1;
+        scroll_ensure_visible(&as->scroll);
+
+        for (int r = 0; r < lh - 1; r++) {
+            int idx = as->scroll.scroll_offset + r;
+            if (idx >= as->order_count) break;
+            const archetype_t *a = &list->archetypes[as->order[idx]];
+            bool is_cursor = (idx == as->scroll.cursor);
+            int draw_row = r + 2;
+
+            if (is_cursor) wattron(lwin, A_REVERSE);
+            wmove(lwin, draw_row, 1);
+            for (int c = 0; c < lw; c++) waddch(lwin, ' ');
+
+            char size_buf[16];
+            format_row_size(a, size_buf, sizeof(size_buf));
+            mvwprintw(lwin, draw_row, 1, "%7d %7s ", a->entity_count, size_buf);
+            if (a->neighbor_count > 0) wattron(lwin, COLOR_PAIR(CP_RECONNECTING));
+            wprintw(lwin, "%4d", a->neighbor_count);
+            if (a->neighbor_count > 0) wattroff(lwin, COLOR_PAIR(CP_RECONNECTING));
+            print_signature(lwin, draw_row, 23, lw - 22, a);
+
+            if (is_cursor) wattroff(lwin, A_REVERSE);
+        }
+    } else {
+        const char *msg = list ? "No entities." : "Waiting for data...";
+        wattron(lwin, A_DIM);
+        mvwprintw(lwin, getmaxy(lwin) / 2, 2, "%s", msg);
+        wattroff(lwin, A_DIM);
+    }
+
+    /* Right panel: world summary, then the selected archetype */
+    WINDOW *rwin = as->panel.right;
+    int rh = getmaxy(rwin) - 2;
+    int rw = getmaxx(rwin) - 2;
+    if (list) {
+        int row = draw_summary(rwin, 1, rw, list);
+        if (as->order_count > 0 && as->scroll.cursor >= 0 &&
+            as->scroll.cursor < as->order_count) {
+            draw_archetype(rwin, row, rh, rw, list, as->order[as->scroll.cursor]);
+        }
+    }
+
+    split_panel_refresh(&as->panel);
+}
+
+/* --- Input --- */
+
+bool tab_archetypes_input(tab_t *self, int ch, void *app_state) {
+    (void)app_state;
+    archetypes_state_t *as = (archetypes_state_t *)self->state;
+    if (!as) return false;
+
+    if (split_panel_handle_focus(&as->panel, ch)) return true;
+
+    switch (ch) {
+    case KEY_UP:
+    case 'k':
+        scroll_move(&as->scroll, -1);
+        return true;
+
+    case KEY_DOWN:
+    case 'j':
+        scroll_move(&as->scroll, +1);
+        return true;
+
+    case KEY_PPAGE:
+        scroll_page(&as->scroll, -1);
+        return true;
+
+    case KEY_NPAGE:
+        scroll_page(&as->scroll, +1);
+        return true;
+
+    case 'g':
+        scroll_to_top(&as->scroll);
+        return true;
+
+    case 'G':
+        scroll_to_bottom(&as->scroll);
+        return true;
+
+    case 'o':
+        /* Cycle the sort key; the cursor goes back to the top of the list */
+        as->sort = (as->sort + 1) % ARCH_SORT_KEY_COUNT;
+        scroll_to_top(&as->scroll);
+        return true;
+    }
+
+    return false;
+}
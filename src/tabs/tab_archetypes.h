@@ -0,0 +1,11 @@
+#ifndef CELS_DEBUG_TAB_ARCHETYPES_H
+#define CELS_DEBUG_TAB_ARCHETYPES_H
+
+#include "../tab_system.h"
+
+void tab_archetypes_init(tab_t *self);
+void tab_archetypes_fini(tab_t *self);
+void tab_archetypes_draw(const tab_t *self, WINDOW *win, const void *app_state);
+bool tab_archetypes_input(tab_t *self, int ch, void *app_state);
+
+#endif /* CELS_DEBUG_TAB_ARCHETYPES_H */
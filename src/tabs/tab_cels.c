@@ -25,6 +25,9 @@ typedef struct cels_state {
     char *prev_entity_json;          /* serialized previous component values */
     char *prev_entity_path;          /* which entity the prev_json belongs to */
     int64_t flash_expire_ms;         /* CLOCK_MONOTONIC ms when flash ends (0 = no flash) */
+
+    /* Entity list generation the tree was last built from */
+    uint64_t seen_entity_list_gen;
 } cels_state_t;
 
 /* Helper: get current monotonic time in milliseconds */
@@ -34,142 +37,18 @@ static int64_t now_ms(void) {
     return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
 }
 
-/* --- Entity classification (CELS-C sections) --- */
-
-/* Check if an entity has a specific tag (substring match on tag name) */
-static bool has_tag(entity_node_t *node, const char *tag_name) {
-    for (int i = 0; i < node->tag_count; i++) {
-        if (node->tags[i] && strstr(node->tags[i], tag_name)) return true;
-    }
-    return false;
-}
-
-/* Check if an entity has "Component" in its component_names */
-static bool has_component_component(entity_node_t *node) {
-    for (int i = 0; i < node->component_count; i++) {
-        if (node->component_names[i] &&
-            strcmp(node->component_names[i], "Component") == 0) return true;
-    }
-    return false;
-}
-
-/* Extract pipeline phase from tags like "flecs.pipeline.OnLoad" -> "OnLoad" */
-static char *extract_pipeline_phase(entity_node_t *node) {
-    for (int i = 0; i < node->tag_count; i++) {
-        if (node->tags[i] && strncmp(node->tags[i], "flecs.pipeline.", 15) == 0) {
-            const char *phase = node->tags[i] + 15;
-            if (phase[0] != '\0') return strdup(phase);
-        }
-    }
-    return NULL;
-}
-
-/* Check if entity is a user-defined lifecycle controller.
- * Matches CEL_Lifecycle macro names: "MainMenuLC", "SettingsCycle", etc.
- * Does NOT match CELS_LifecycleSystem (that's a system, not a lifecycle). */
-static bool name_is_lifecycle(entity_node_t *node) {
-    if (!node->name) return false;
-    /* Suffix: CEL_Lifecycle macro names (MainMenuLC, SettingsLC, MenuCycle) */
-    size_t nlen = strlen(node->name);
-    if (nlen >= 2 && strcmp(node->name + nlen - 2, "LC") == 0) return true;
-    if (nlen >= 5 && strcmp(node->name + nlen - 5, "Cycle") == 0) return true;
-    /* Legacy: "lifecycle_0x..." prefix from old naming */
-    if (strncmp(node->name, "lifecycle_", 10) == 0) return true;
-    return false;
-}
-
-/* Check if name ends with "State" (case-sensitive) */
-static bool name_ends_with_state(entity_node_t *node) {
-    if (!node->name) return false;
-    const char *suffix = "State";
-    size_t nlen = strlen(node->name);
-    size_t slen = strlen(suffix);
-    if (nlen < slen) return false;
-    return strcmp(node->name + nlen - slen, suffix) == 0;
-}
-
-/* Classify a single node (root-level only -- children inherit) */
-static entity_class_t classify_node(entity_node_t *node) {
-    free(node->class_detail);
-    node->class_detail = NULL;
-
-    /* Systems -- flecs.system.System tag, observers */
-    if (has_tag(node, "flecs.system.System")) {
-        node->class_detail = extract_pipeline_phase(node);
-        if (!node->class_detail) node->class_detail = strdup("System");
-        return ENTITY_CLASS_SYSTEM;
-    }
-    if (has_tag(node, "flecs.core.Observer")) {
-        node->class_detail = strdup("Observer");
-        return ENTITY_CLASS_SYSTEM;
-    }
-    /* L: Lifecycles -- user-defined lifecycle entities (after system check so
-       CELS_LifecycleSystem stays classified as a system) */
-    if (name_is_lifecycle(node)) {
-        return ENTITY_CLASS_LIFECYCLE;
-    }
-    /* Components -- component type entities */
-    if (has_component_component(node)) {
-        return ENTITY_CLASS_COMPONENT;
-    }
-    /* S: State -- entities whose name ends with "State" */
-    if (name_ends_with_state(node)) {
-        return ENTITY_CLASS_STATE;
-    }
-    /* E: Entities -- leaf scene entities (no children, have component data) */
-    if (node->child_count == 0 && node->component_count > 0) {
-        return ENTITY_CLASS_ENTITY;
-    }
-    /* C: Compositions -- parent entities (have children = scene structure) */
-    return ENTITY_CLASS_COMPOSITION;
-}
-
-/* Propagate a class to all descendants */
-static void propagate_class(entity_node_t *node, entity_class_t cls) {
-    node->entity_class = cls;
-    for (int i = 0; i < node->child_count; i++) {
-        propagate_class(node->children[i], cls);
-    }
-}
+/* --- Helper: bring the tree up to date with the current datasets --- */
 
-/* Classify all roots in entity list -- children inherit root's class */
-static void classify_all_entities(entity_list_t *list) {
-    if (!list) return;
-    for (int i = 0; i < list->root_count; i++) {
-        entity_class_t cls = classify_node(list->roots[i]);
-        propagate_class(list->roots[i], cls);
-    }
-}
+/* Rows only change with the entity list (classification and registry
+ * annotation are done by analysis_update). Also called before handling
+ * input: the tree's rows point into entity_list and must be rebuilt
+ * before use once the list has been replaced. */
+static void sync_tree(cels_state_t *cs, const app_state_t *state) {
+    if (!state->entity_list) return;
+    if (cs->seen_entity_list_gen == state->entity_list_gen) return;
 
-/* --- Annotation: enrich component entities with registry data --- */
-
-static void annotate_component_entities(entity_list_t *list,
-                                         component_registry_t *reg) {
-    if (!list || !reg) return;
-    for (int i = 0; i < list->root_count; i++) {
-        entity_node_t *node = list->roots[i];
-        if (node->entity_class != ENTITY_CLASS_COMPONENT) continue;
-        if (!node->name) continue;
-
-        /* Find matching registry entry */
-        for (int r = 0; r < reg->count; r++) {
-            if (reg->components[r].name &&
-                strcmp(reg->components[r].name, node->name) == 0) {
-                free(node->class_detail);
-                char buf[64];
-                if (reg->components[r].has_type_info && reg->components[r].size > 0) {
-                    snprintf(buf, sizeof(buf), "%d entities, %dB",
-                             reg->components[r].entity_count,
-                             reg->components[r].size);
-                } else {
-                    snprintf(buf, sizeof(buf), "%d entities",
-                             reg->components[r].entity_count);
-                }
-                node->class_detail = strdup(buf);
-                break;
-            }
-        }
-    }
+    tree_view_rebuild_visible(&cs->tree, state->entity_list);
+    cs->seen_entity_list_gen = state->entity_list_gen;
 }
 
 /* --- Helper: count inspector content rows for scroll total --- */
@@ -300,6 +179,7 @@ static void sync_selected_path(cels_state_t *cs, app_state_t *state) {
         strcmp(state->entity_detail->path, sel->full_path) != 0) {
         entity_detail_free(state->entity_detail);
         state->entity_detail = NULL;
+        state->entity_detail_gen++;
     }
 }
 
@@ -397,6 +277,11 @@ void tab_cels_draw(const tab_t *self, WINDOW *win, const void *app_state) {
 
     const app_state_t *state = (const app_state_t *)app_state;
 
+    /* A flash that has ended no longer needs a timed redraw */
+    if (cs->flash_expire_ms > 0 && now_ms() >= cs->flash_expire_ms) {
+        cs->flash_expire_ms = 0;
+    }
+
     int h = getmaxy(win);
     int w = getmaxx(win);
 
@@ -414,13 +299,7 @@ void tab_cels_draw(const tab_t *self, WINDOW *win, const void *app_state) {
 
     /* --- Left panel: entity tree --- */
     if (state->entity_list) {
-        /* Classify entities into CELS sections */
-        classify_all_entities(state->entity_list);
-
-        /* Annotate component entities with registry data (entity count, size) */
-        annotate_component_entities(state->entity_list, state->component_registry);
-
-        tree_view_rebuild_visible(&cs->tree, state->entity_list);
+        sync_tree(cs, state);
 
         /* Auto-select first entity if nothing selected yet */
         if (!state->selected_entity_path && cs->tree.row_count > 0) {
@@ -459,91 +338,76 @@ void tab_cels_draw(const tab_t *self, WINDOW *win, const void *app_state) {
             entity_list_t *elist = state->entity_list;
 
             /* Filter entities that have the selected component */
-            int match_cap = elist->count;
-            entity_node_t **matches = malloc((size_t)match_cap * sizeof(entity_node_t *));
             int match_count = 0;
+            entity_node_t *const *matches = entity_list_with_component(
+                elist, intern_find(comp_name), &match_count);
 
-            if (matches) {
-                for (int i = 0; i < elist->count; i++) {
-                    entity_node_t *node = elist->nodes[i];
-                    for (int c = 0; c < node->component_count; c++) {
-                        if (node->component_names[c] &&
-                            strcmp(node->component_names[c], comp_name) == 0) {
-                            matches[match_count++] = node;
-                            break;
-                        }
-                    }
-                }
-
-                /* Header */
-                wattron(rwin, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
-                mvwprintw(rwin, 1, 1, "Entities with %.*s", rw - 14, comp_name);
-                wattroff(rwin, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
+            /* Header */
+            wattron(rwin, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
+            mvwprintw(rwin, 1, 1, "Entities with %.*s", rw - 14, comp_name);
+            wattroff(rwin, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
 
-                /* Update scroll state for entity list (below header) */
-                cs->inspector_scroll.total_items = match_count;
-                cs->inspector_scroll.visible_rows = rh - 1; /* minus header row */
-                scroll_ensure_visible(&cs->inspector_scroll);
+            /* Update scroll state for entity list (below header) */
+            cs->inspector_scroll.total_items = match_count;
+            cs->inspector_scroll.visible_rows = rh - 1; /* minus header row */
+            scroll_ensure_visible(&cs->inspector_scroll);
 
-                if (match_count > 0) {
-                    /* Render visible matching entities */
-                    int avail_rows = rh - 1;
-                    for (int row = 0; row < avail_rows &&
-                         cs->inspector_scroll.scroll_offset + row < match_count; row++) {
-                        int idx = cs->inspector_scroll.scroll_offset + row;
-                        entity_node_t *ent = matches[idx];
+            if (match_count > 0) {
+                /* Render visible matching entities */
+                int avail_rows = rh - 1;
+                for (int row = 0; row < avail_rows &&
+                     cs->inspector_scroll.scroll_offset + row < match_count; row++) {
+                    int idx = cs->inspector_scroll.scroll_offset + row;
+                    entity_node_t *ent = matches[idx];
 
-                        bool is_cursor = (idx == cs->inspector_scroll.cursor);
+                    bool is_cursor = (idx == cs->inspector_scroll.cursor);
 
-                        if (is_cursor && cs->panel.focus == 1) {
-                            wattron(rwin, A_REVERSE);
-                        }
+                    if (is_cursor && cs->panel.focus == 1) {
+                        wattron(rwin, A_REVERSE);
+                    }
 
-                        /* Clear the row inside border */
-                        wmove(rwin, row + 2, 1);
-                        for (int c = 0; c < rw; c++) waddch(rwin, ' ');
-
-                        /* Entity name (or #<id> for anonymous) */
-                        const char *display_name;
-                        char id_buf[32];
-                        if (ent->name && strlen(ent->name) > 0) {
-                            display_name = ent->name;
-                        } else {
-                            snprintf(id_buf, sizeof(id_buf), "#%lu",
-                                     (unsigned long)ent->id);
-                            display_name = id_buf;
-                        }
+                    /* Clear the row inside border */
+                    wmove(rwin, row + 2, 1);
+                    for (int c = 0; c < rw; c++) waddch(rwin, ' ');
+
+                    /* Entity name (or #<id> for anonymous) */
+                    const char *display_name;
+                    char id_buf[32];
+                    if (ent->name && strlen(ent->name) > 0) {
+                        display_name = ent->name;
+                    } else {
+                        snprintf(id_buf, sizeof(id_buf), "#%lu",
+                                 (unsigned long)ent->id);
+                        display_name = id_buf;
+                    }
 
-                        wattron(rwin, COLOR_PAIR(CP_ENTITY_NAME));
-                        mvwprintw(rwin, row + 2, 2, "%.*s", rw / 2, display_name);
-                        wattroff(rwin, COLOR_PAIR(CP_ENTITY_NAME));
-
-                        /* Full path in dim to the right */
-                        if (ent->full_path) {
-                            int name_end = getcurx(rwin);
-                            int path_col = name_end + 1;
-                            int avail = rw - (path_col - 1);
-                            if (avail > 2) {
-                                wattron(rwin, A_DIM);
-                                mvwprintw(rwin, row + 2, path_col, "%.*s",
-                                          avail, ent->full_path);
-                                wattroff(rwin, A_DIM);
-                            }
+                    wattron(rwin, COLOR_PAIR(CP_ENTITY_NAME));
+                    mvwprintw(rwin, row + 2, 2, "%.*s", rw / 2, display_name);
+                    wattroff(rwin, COLOR_PAIR(CP_ENTITY_NAME));
+
+                    /* Full path in dim to the right */
+                    if (ent->full_path) {
+                        int name_end = getcurx(rwin);
+                        int path_col = name_end + 1;
+                        int avail = rw - (path_col - 1);
+                        if (avail > 2) {
+                            wattron(rwin, A_DIM);
+                            mvwprintw(rwin, row + 2, path_col, "%.*s",
+                                      avail, ent->full_path);
+                            wattroff(rwin, A_DIM);
                         }
+                    }
 
-                        if (is_cursor && cs->panel.focus == 1) {
-                            wattroff(rwin, A_REVERSE);
-                        }
+                    if (is_cursor && cs->panel.focus == 1) {
+                        wattroff(rwin, A_REVERSE);
                     }
-                } else {
-                    const char *msg = "No entities";
-                    int msg_len = (int)strlen(msg);
-                    wattron(rwin, A_DIM);
-                    mvwprintw(rwin, rh / 2 + 1, (rw - msg_len) / 2 + 1, "%s", msg);
-                    wattroff(rwin, A_DIM);
                 }
-
-                free(matches);
+            } else {
+                const char *msg = "No entities";
+                int msg_len = (int)strlen(msg);
+                wattron(rwin, A_DIM);
+                mvwprintw(rwin, rh / 2 + 1, (rw - msg_len) / 2 + 1, "%s", msg);
+                wattroff(rwin, A_DIM);
             }
         } else if (comp_name && (!state->entity_list || state->entity_list->count == 0)) {
             const char *msg = "Waiting for entity data...";
@@ -768,11 +632,18 @@ void tab_cels_draw(const tab_t *self, WINDOW *win, const void *app_state) {
 
 /* --- Input --- */
 
+/* Redraw once more when the value flash ends */
+int64_t tab_cels_redraw_deadline(const tab_t *self) {
+    const cels_state_t *cs = (const cels_state_t *)self->state;
+    return cs ? cs->flash_expire_ms : 0;
+}
+
 bool tab_cels_input(tab_t *self, int ch, void *app_state) {
     cels_state_t *cs = (cels_state_t *)self->state;
     if (!cs) return false;
 
     app_state_t *state = (app_state_t *)app_state;
+    sync_tree(cs, state);
 
     /* Focus switching: left/right arrows */
     if (split_panel_handle_focus(&cs->panel, ch)) return true;
@@ -7,5 +7,6 @@ void tab_cels_init(tab_t *self);
 void tab_cels_fini(tab_t *self);
 void tab_cels_draw(const tab_t *self, WINDOW *win, const void *app_state);
 bool tab_cels_input(tab_t *self, int ch, void *app_state);
+int64_t tab_cels_redraw_deadline(const tab_t *self);
 
 #endif /* CELS_DEBUG_TAB_CELS_H */
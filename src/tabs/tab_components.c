@@ -158,83 +158,67 @@ void tab_components_draw(const tab_t *self, WINDOW *win, const void *app_state)
             /* Filter entities that have the selected component */
             entity_list_t *elist = state->entity_list;
 
-            /* Temporary array of matching entity pointers (stack-allocated up to a limit) */
-            int match_cap = elist->count;
-            entity_node_t **matches = malloc((size_t)match_cap * sizeof(entity_node_t *));
             int match_count = 0;
+            entity_node_t *const *matches = entity_list_with_component(
+                elist, intern_find(sel_name), &match_count);
 
-            if (matches) {
-                for (int i = 0; i < elist->count; i++) {
-                    entity_node_t *node = elist->nodes[i];
-                    for (int c = 0; c < node->component_count; c++) {
-                        if (node->component_names[c] &&
-                            strcmp(node->component_names[c], sel_name) == 0) {
-                            matches[match_count++] = node;
-                            break;
-                        }
-                    }
-                }
+            /* Update right scroll */
+            cs->right_scroll.total_items = match_count;
+            cs->right_scroll.visible_rows = rh;
+            scroll_ensure_visible(&cs->right_scroll);
 
-                /* Update right scroll */
-                cs->right_scroll.total_items = match_count;
-                cs->right_scroll.visible_rows = rh;
-                scroll_ensure_visible(&cs->right_scroll);
+            if (match_count > 0) {
+                /* Render visible matching entities */
+                for (int row = 0; row < rh && cs->right_scroll.scroll_offset + row < match_count; row++) {
+                    int idx = cs->right_scroll.scroll_offset + row;
+                    entity_node_t *ent = matches[idx];
 
-                if (match_count > 0) {
-                    /* Render visible matching entities */
-                    for (int row = 0; row < rh && cs->right_scroll.scroll_offset + row < match_count; row++) {
-                        int idx = cs->right_scroll.scroll_offset + row;
-                        entity_node_t *ent = matches[idx];
+                    bool is_cursor = (idx == cs->right_scroll.cursor);
 
-                        bool is_cursor = (idx == cs->right_scroll.cursor);
-
-                        if (is_cursor && cs->panel.focus == 1) {
-                            wattron(rwin, A_REVERSE);
-                        }
+                    if (is_cursor && cs->panel.focus == 1) {
+                        wattron(rwin, A_REVERSE);
+                    }
 
-                        /* Clear the row inside border */
-                        wmove(rwin, row + 1, 1);
-                        for (int c = 0; c < rw; c++) waddch(rwin, ' ');
-
-                        /* Entity name (or #<id> for anonymous) */
-                        const char *display_name;
-                        char id_buf[32];
-                        if (ent->name && strlen(ent->name) > 0) {
-                            display_name = ent->name;
-                        } else {
-                            snprintf(id_buf, sizeof(id_buf), "#%lu", (unsigned long)ent->id);
-                            display_name = id_buf;
-                        }
+                    /* Clear the row inside border */
+                    wmove(rwin, row + 1, 1);
+                    for (int c = 0; c < rw; c++) waddch(rwin, ' ');
+
+                    /* Entity name (or #<id> for anonymous) */
+                    const char *display_name;
+                    char id_buf[32];
+                    if (ent->name && strlen(ent->name) > 0) {
+                        display_name = ent->name;
+                    } else {
+                        snprintf(id_buf, sizeof(id_buf), "#%lu", (unsigned long)ent->id);
+                        display_name = id_buf;
+                    }
 
-                        wattron(rwin, COLOR_PAIR(CP_ENTITY_NAME));
-                        mvwprintw(rwin, row + 1, 2, "%.*s", rw / 2, display_name);
-                        wattroff(rwin, COLOR_PAIR(CP_ENTITY_NAME));
-
-                        /* Full path in dim to the right (truncated to fit) */
-                        if (ent->full_path) {
-                            int name_end = getcurx(rwin);
-                            int path_col = name_end + 1;
-                            int avail = rw - (path_col - 1);
-                            if (avail > 2) {
-                                wattron(rwin, A_DIM);
-                                mvwprintw(rwin, row + 1, path_col, "%.*s", avail, ent->full_path);
-                                wattroff(rwin, A_DIM);
-                            }
+                    wattron(rwin, COLOR_PAIR(CP_ENTITY_NAME));
+                    mvwprintw(rwin, row + 1, 2, "%.*s", rw / 2, display_name);
+                    wattroff(rwin, COLOR_PAIR(CP_ENTITY_NAME));
+
+                    /* Full path in dim to the right (truncated to fit) */
+                    if (ent->full_path) {
+                        int name_end = getcurx(rwin);
+                        int path_col = name_end + 1;
+                        int avail = rw - (path_col - 1);
+                        if (avail > 2) {
+                            wattron(rwin, A_DIM);
+                            mvwprintw(rwin, row + 1, path_col, "%.*s", avail, ent->full_path);
+                            wattroff(rwin, A_DIM);
                         }
+                    }
 
-                        if (is_cursor && cs->panel.focus == 1) {
-                            wattroff(rwin, A_REVERSE);
-                        }
+                    if (is_cursor && cs->panel.focus == 1) {
+                        wattroff(rwin, A_REVERSE);
                     }
-                } else {
-                    const char *msg = "No entities";
-                    int msg_len = (int)strlen(msg);
-                    wattron(rwin, A_DIM);
-                    mvwprintw(rwin, rh / 2 + 1, (rw - msg_len) / 2 + 1, "%s", msg);
-                    wattroff(rwin, A_DIM);
                 }
-
-                free(matches);
+            } else {
+                const char *msg = "No entities";
+                int msg_len = (int)strlen(msg);
+                wattron(rwin, A_DIM);
+                mvwprintw(rwin, rh / 2 + 1, (rw - msg_len) / 2 + 1, "%s", msg);
+                wattroff(rwin, A_DIM);
             }
         } else if (sel_name && (!state->entity_list || state->entity_list->count == 0)) {
             const char *msg = "Waiting for entity data...";
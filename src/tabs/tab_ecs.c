@@ -47,136 +47,13 @@ static int phase_color_pair(const char *phase) {
     return CP_PHASE_CUSTOM;
 }
 
-/* --- Entity classification (CELS-C sections) --- */
+/* --- Phase grouping for the tree --- */
 
-/* Check if an entity has a specific tag (substring match on tag name) */
-static bool has_tag(entity_node_t *node, const char *tag_name) {
-    for (int i = 0; i < node->tag_count; i++) {
-        if (node->tags[i] && strstr(node->tags[i], tag_name)) return true;
-    }
-    return false;
-}
-
-/* Check if an entity has "Component" in its component_names */
-static bool has_component_component(entity_node_t *node) {
-    for (int i = 0; i < node->component_count; i++) {
-        if (node->component_names[i] &&
-            strcmp(node->component_names[i], "Component") == 0) return true;
-    }
-    return false;
-}
-
-/* Extract pipeline phase from tags like "flecs.pipeline.OnLoad" -> "OnLoad" */
-static char *extract_pipeline_phase(entity_node_t *node) {
-    for (int i = 0; i < node->tag_count; i++) {
-        if (node->tags[i] && strncmp(node->tags[i], "flecs.pipeline.", 15) == 0) {
-            const char *phase = node->tags[i] + 15;
-            if (phase[0] != '\0') return strdup(phase);
-        }
-    }
-    return NULL;
-}
-
-/* Check if entity is a user-defined lifecycle controller.
- * Matches CEL_Lifecycle macro names: "MainMenuLC", "SettingsLC", "MenuCycle", etc.
- * Does NOT match CELS_LifecycleSystem (that's a system, not a lifecycle). */
-static bool name_is_lifecycle(entity_node_t *node) {
-    if (!node->name) return false;
-    size_t nlen = strlen(node->name);
-    if (nlen >= 2 && strcmp(node->name + nlen - 2, "LC") == 0) return true;
-    if (nlen >= 5 && strcmp(node->name + nlen - 5, "Cycle") == 0) return true;
-    if (strncmp(node->name, "lifecycle_", 10) == 0) return true;
-    return false;
-}
-
-/* Classify a single node (root-level only -- children inherit) */
-static entity_class_t classify_node(entity_node_t *node) {
-    free(node->class_detail);
-    node->class_detail = NULL;
-
-    /* Systems -- flecs.system.System tag, observers */
-    if (has_tag(node, "flecs.system.System")) {
-        node->class_detail = extract_pipeline_phase(node);
-        if (!node->class_detail) node->class_detail = strdup("System");
-        return ENTITY_CLASS_SYSTEM;
-    }
-    if (has_tag(node, "flecs.core.Observer")) {
-        node->class_detail = strdup("Observer");
-        return ENTITY_CLASS_SYSTEM;
-    }
-    /* L: Lifecycles -- user-defined lifecycle entities (after system check so
-       CELS_LifecycleSystem stays classified as a system) */
-    if (name_is_lifecycle(node)) {
-        return ENTITY_CLASS_LIFECYCLE;
-    }
-    /* Components -- component type entities */
-    if (has_component_component(node)) {
-        return ENTITY_CLASS_COMPONENT;
-    }
-    /* E: Entities -- leaf scene entities (no children, have component data) */
-    if (node->child_count == 0 && node->component_count > 0) {
-        return ENTITY_CLASS_ENTITY;
-    }
-    /* C: Compositions -- parent entities (have children = scene structure) */
-    return ENTITY_CLASS_COMPOSITION;
-}
-
-/* Propagate a class to all descendants */
-static void propagate_class(entity_node_t *node, entity_class_t cls) {
-    node->entity_class = cls;
-    for (int i = 0; i < node->child_count; i++) {
-        propagate_class(node->children[i], cls);
-    }
-}
-
-/* Classify all roots in entity list -- children inherit root's class */
-static void classify_all_entities(entity_list_t *list) {
-    if (!list) return;
-    for (int i = 0; i < list->root_count; i++) {
-        entity_class_t cls = classify_node(list->roots[i]);
-        propagate_class(list->roots[i], cls);
-    }
-}
-
-/* --- Annotation: enrich component entities with registry data --- */
-
-static void annotate_component_entities(entity_list_t *list,
-                                         component_registry_t *reg) {
-    if (!list || !reg) return;
-    for (int i = 0; i < list->root_count; i++) {
-        entity_node_t *node = list->roots[i];
-        if (node->entity_class != ENTITY_CLASS_COMPONENT) continue;
-        if (!node->name) continue;
-
-        /* Find matching registry entry */
-        for (int r = 0; r < reg->count; r++) {
-            if (reg->components[r].name &&
-                strcmp(reg->components[r].name, node->name) == 0) {
-                free(node->class_detail);
-                char buf[64];
-                if (reg->components[r].has_type_info && reg->components[r].size > 0) {
-                    snprintf(buf, sizeof(buf), "%d entities, %dB",
-                             reg->components[r].entity_count,
-                             reg->components[r].size);
-                } else {
-                    snprintf(buf, sizeof(buf), "%d entities",
-                             reg->components[r].entity_count);
-                }
-                node->class_detail = strdup(buf);
-                break;
-            }
-        }
-    }
-}
-
-/* --- Enrichment: merge pipeline stats into system entity nodes --- */
-
-/* Enrich system entity nodes with data from pipeline stats.
- * Matches by leaf name (fast, sufficient for small apps).
- * Also builds the phase list for tree_view phase sub-headers. */
-static void enrich_systems_with_pipeline(entity_list_t *list,
-                                          system_registry_t *reg,
-                                          tree_view_t *tree) {
+/* Build the phase list for tree_view phase sub-headers from the system
+ * entities (classified and enriched by analysis_update). */
+static void build_phase_list(entity_list_t *list,
+                             system_registry_t *reg,
+                             tree_view_t *tree) {
     if (!list || !reg || reg->count == 0) {
         tree_view_set_phases(tree, NULL, NULL, 0);
         return;
@@ -201,7 +78,7 @@ static void enrich_systems_with_pipeline(entity_list_t *list,
             }
         }
         if (!exists && found_count < 32) {
-            found_phases[found_count] = node->class_detail;
+            found_phases[found_count] = (char *)node->class_detail;
             found_counts[found_count] = 1;
             found_count++;
         }
@@ -233,21 +110,6 @@ static void enrich_systems_with_pipeline(entity_list_t *list,
 
     tree_view_set_phases(tree, found_phases, found_counts, found_count);
 
-    /* Enrich each system entity with pipeline stats (match by leaf name) */
-    for (int i = 0; i < list->root_count; i++) {
-        entity_node_t *node = list->roots[i];
-        if (node->entity_class != ENTITY_CLASS_SYSTEM) continue;
-        if (!node->name) continue;
-
-        for (int s = 0; s < reg->count; s++) {
-            if (reg->systems[s].name &&
-                strcmp(reg->systems[s].name, node->name) == 0) {
-                node->system_match_count = reg->systems[s].matched_entity_count;
-                node->disabled = reg->systems[s].disabled;
-                break;
-            }
-        }
-    }
 }
 
 /* --- Helper: count inspector content rows for scroll total --- */
@@ -406,13 +268,15 @@ static entity_node_t **build_system_matches(const entity_detail_t *sys_detail,
     if (comp_count == 0) return NULL;
 
     /* Filter out system-internal components */
-    const char *query_comps[64];
+    intern_id_t query_comps[64];
     int query_count = 0;
     for (int i = 0; i < comp_count; i++) {
         if (!comp_names[i]) continue;
         if (strncmp(comp_names[i], "flecs.", 6) == 0) continue;
         if (strcmp(comp_names[i], "Component") == 0) continue;
-        query_comps[query_count++] = comp_names[i];
+        /* Never interned means no listed entity carries it */
+        intern_id_t id = intern_find(comp_names[i]);
+        if (id != INTERN_NONE) query_comps[query_count++] = id;
     }
     if (query_count == 0) return NULL;
 
@@ -429,8 +293,7 @@ static entity_node_t **build_system_matches(const entity_detail_t *sys_detail,
         bool has_match = false;
         for (int q = 0; q < query_count && !has_match; q++) {
             for (int c = 0; c < node->component_count; c++) {
-                if (node->component_names[c] &&
-                    strcmp(node->component_names[c], query_comps[q]) == 0) {
+                if (node->component_ids[c] == query_comps[q]) {
                     has_match = true;
                     break;
                 }
@@ -992,14 +855,8 @@ void tab_ecs_draw(const tab_t *self, WINDOW *win, const void *app_state) {
 
     /* --- Left panel: entity tree --- */
     if (state->entity_list) {
-        /* Classify entities into CELS-C sections */
-        classify_all_entities(state->entity_list);
-
-        /* Annotate component entities with registry data (entity count, size) */
-        annotate_component_entities(state->entity_list, state->component_registry);
-
-        /* Enrich system entities with pipeline stats + build phase grouping */
-        enrich_systems_with_pipeline(state->entity_list, state->system_registry, &es->tree);
+        /* Phase grouping (classification is done by analysis_update) */
+        build_phase_list(state->entity_list, state->system_registry, &es->tree);
 
         tree_view_rebuild_visible(&es->tree, state->entity_list);
 
@@ -1056,91 +913,76 @@ void tab_ecs_draw(const tab_t *self, WINDOW *win, const void *app_state) {
             entity_list_t *elist = state->entity_list;
 
             /* Filter entities that have the selected component */
-            int match_cap = elist->count;
-            entity_node_t **matches = malloc((size_t)match_cap * sizeof(entity_node_t *));
             int match_count = 0;
+            entity_node_t *const *matches = entity_list_with_component(
+                elist, intern_find(comp_name), &match_count);
 
-            if (matches) {
-                for (int i = 0; i < elist->count; i++) {
-                    entity_node_t *node = elist->nodes[i];
-                    for (int c = 0; c < node->component_count; c++) {
-                        if (node->component_names[c] &&
-                            strcmp(node->component_names[c], comp_name) == 0) {
-                            matches[match_count++] = node;
-                            break;
-                        }
-                    }
-                }
-
-                /* Header */
-                wattron(rwin, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
-                mvwprintw(rwin, 1, 1, "Entities with %.*s", rw - 14, comp_name);
-                wattroff(rwin, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
+            /* Header */
+            wattron(rwin, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
+            mvwprintw(rwin, 1, 1, "Entities with %.*s", rw - 14, comp_name);
+            wattroff(rwin, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
 
-                /* Update scroll state for entity list (below header) */
-                es->inspector_scroll.total_items = match_count;
-                es->inspector_scroll.visible_rows = rh - 1; /* minus header row */
-                scroll_ensure_visible(&es->inspector_scroll);
+            /* Update scroll state for entity list (below header) */
+            es->inspector_scroll.total_items = match_count;
+            es->inspector_scroll.visible_rows = rh - 1; /* minus header row */
+            scroll_ensure_visible(&es->inspector_scroll);
 
-                if (match_count > 0) {
-                    /* Render visible matching entities */
-                    int avail_rows = rh - 1;
-                    for (int row = 0; row < avail_rows &&
-                         es->inspector_scroll.scroll_offset + row < match_count; row++) {
-                        int idx = es->inspector_scroll.scroll_offset + row;
-                        entity_node_t *ent = matches[idx];
+            if (match_count > 0) {
+                /* Render visible matching entities */
+                int avail_rows = rh - 1;
+                for (int row = 0; row < avail_rows &&
+                     es->inspector_scroll.scroll_offset + row < match_count; row++) {
+                    int idx = es->inspector_scroll.scroll_offset + row;
+                    entity_node_t *ent = matches[idx];
 
-                        bool is_cursor = (idx == es->inspector_scroll.cursor);
+                    bool is_cursor = (idx == es->inspector_scroll.cursor);
 
-                        if (is_cursor && es->panel.focus == 1) {
-                            wattron(rwin, A_REVERSE);
-                        }
+                    if (is_cursor && es->panel.focus == 1) {
+                        wattron(rwin, A_REVERSE);
+                    }
 
-                        /* Clear the row inside border */
-                        wmove(rwin, row + 2, 1);
-                        for (int c = 0; c < rw; c++) waddch(rwin, ' ');
-
-                        /* Entity name (or #<id> for anonymous) */
-                        const char *display_name;
-                        char id_buf[32];
-                        if (ent->name && strlen(ent->name) > 0) {
-                            display_name = ent->name;
-                        } else {
-                            snprintf(id_buf, sizeof(id_buf), "#%lu",
-                                     (unsigned long)ent->id);
-                            display_name = id_buf;
-                        }
+                    /* Clear the row inside border */
+                    wmove(rwin, row + 2, 1);
+                    for (int c = 0; c < rw; c++) waddch(rwin, ' ');
+
+                    /* Entity name (or #<id> for anonymous) */
+                    const char *display_name;
+                    char id_buf[32];
+                    if (ent->name && strlen(ent->name) > 0) {
+                        display_name = ent->name;
+                    } else {
+                        snprintf(id_buf, sizeof(id_buf), "#%lu",
+                                 (unsigned long)ent->id);
+                        display_name = id_buf;
+                    }
 
-                        wattron(rwin, COLOR_PAIR(CP_ENTITY_NAME));
-                        mvwprintw(rwin, row + 2, 2, "%.*s", rw / 2, display_name);
-                        wattroff(rwin, COLOR_PAIR(CP_ENTITY_NAME));
-
-                        /* Full path in dim to the right */
-                        if (ent->full_path) {
-                            int name_end = getcurx(rwin);
-                            int path_col = name_end + 1;
-                            int avail = rw - (path_col - 1);
-                            if (avail > 2) {
-                                wattron(rwin, A_DIM);
-                                mvwprintw(rwin, row + 2, path_col, "%.*s",
-                                          avail, ent->full_path);
-                                wattroff(rwin, A_DIM);
-                            }
+                    wattron(rwin, COLOR_PAIR(CP_ENTITY_NAME));
+                    mvwprintw(rwin, row + 2, 2, "%.*s", rw / 2, display_name);
+                    wattroff(rwin, COLOR_PAIR(CP_ENTITY_NAME));
+
+                    /* Full path in dim to the right */
+                    if (ent->full_path) {
+                        int name_end = getcurx(rwin);
+                        int path_col = name_end + 1;
+                        int avail = rw - (path_col - 1);
+                        if (avail > 2) {
+                            wattron(rwin, A_DIM);
+                            mvwprintw(rwin, row + 2, path_col, "%.*s",
+                                      avail, ent->full_path);
+                            wattroff(rwin, A_DIM);
                         }
+                    }
 
-                        if (is_cursor && es->panel.focus == 1) {
-                            wattroff(rwin, A_REVERSE);
-                        }
+                    if (is_cursor && es->panel.focus == 1) {
+                        wattroff(rwin, A_REVERSE);
                     }
-                } else {
-                    const char *msg = "No entities";
-                    int msg_len = (int)strlen(msg);
-                    wattron(rwin, A_DIM);
-                    mvwprintw(rwin, rh / 2 + 1, (rw - msg_len) / 2 + 1, "%s", msg);
-                    wattroff(rwin, A_DIM);
                 }
-
-                free(matches);
+            } else {
+                const char *msg = "No entities";
+                int msg_len = (int)strlen(msg);
+                wattron(rwin, A_DIM);
+                mvwprintw(rwin, rh / 2 + 1, (rw - msg_len) / 2 + 1, "%s", msg);
+                wattroff(rwin, A_DIM);
             }
         } else if (comp_name && (!state->entity_list || state->entity_list->count == 0)) {
             const char *msg = "Waiting for entity data...";
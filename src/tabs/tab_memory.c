@@ -0,0 +1,368 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "tab_memory.h"
+#include "../tui.h"
+#include "../footprint.h"
+#include "../scroll.h"
+#include "../widgets.h"
+#include <ncurses.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Component memory: size x entity_count per component from the footprint
+ * tracker, grouped by module (the name up to its last '.') with modules
+ * and their components sorted by footprint. 'f' flattens the list into
+ * one ranking. Components flagged by footprint_series_growing() are
+ * highlighted. Components that never took any bytes (tags, types without
+ * size info) are left out. Samples are taken whenever the registry is
+ * polled: while a tab that shows components is open, or all session
+ * with -f. */
+
+/* One module (namespace) of components */
+typedef struct mem_module {
+    const char *name;       /* points into an interned component name */
+    int name_len;           /* 0 = root namespace */
+    uint64_t bytes;
+    uint64_t first_bytes;   /* sum of the components' first footprints */
+    int component_count;
+    int growing_count;
+} mem_module_t;
+
+/* Display row: module header or component */
+typedef struct mem_row {
+    int module;             /* index into modules, -1 in flat mode */
+    int series;             /* index into footprints.series, -1 for headers */
+} mem_row_t;
+
+/* Per-tab private state */
+typedef struct memory_state {
+    scroll_state_t scroll;
+    bool flat;
+
+    mem_module_t *modules;
+    int module_count;
+    mem_row_t *rows;
+    int row_count;
+
+    uint64_t seen_seq;      /* footprint samples the rows were built from */
+    bool seen_flat;
+    bool built;
+} memory_state_t;
+
+/* --- Helpers --- */
+
+/* Signed change, "+1.5K" / "-200B" / "0" */
+static void format_delta(uint64_t now, uint64_t then, char *buf, size_t size) {
+    if (now == then) {
+        snprintf(buf, size, "0");
+        return;
+    }
+    char num[24];
+    format_bytes(now > then ? (double)(now - then) : (double)(then - now), num, sizeof(num));
+    snprintf(buf, size, "%c%s", now > then ? '+' : '-', num);
+}
+
+static int module_len(const char *name) {
+    const char *dot = strrchr(name, '.');
+    return dot ? (int)(dot - name) : 0;
+}
+
+/* Latest samples, one column each */
+static void draw_footprint_sparkline(WINDOW *win, int row, int col,
+                                     const footprint_tracker_t *t,
+                                     const footprint_series_t *s, int color) {
+    uint64_t v[SPARK_WIDTH];
+    double d[SPARK_WIDTH];
+    int n = footprint_tracker_recent(t, s, v, SPARK_WIDTH);
+    for (int i = 0; i < n; i++) d[i] = (double)v[i];
+    draw_sparkline(win, row, col, d, n, color);
+}
+
+/* --- Row building --- */
+
+static const footprint_series_t *sort_series;   /* qsort context */
+static const mem_module_t *sort_modules;
+
+static int cmp_series_bytes(const void *a, const void *b) {
+    const mem_row_t *ra = a, *rb = b;
+    if (ra->module != rb->module) {
+        const mem_module_t *ma = &sort_modules[ra->module];
+        const mem_module_t *mb = &sort_modules[rb->module];
+        if (ma->bytes != mb->bytes) return ma->bytes < mb->bytes ? 1 : -1;
+        return ra->module - rb->module;
+    }
+    /* Header first within its module */
+    if (ra->series < 0 || rb->series < 0) return ra->series < 0 ? -1 : 1;
+    const footprint_series_t *sa = &sort_series[ra->series];
+    const footprint_series_t *sb = &sort_series[rb->series];
+    if (sa->bytes != sb->bytes) return sa->bytes < sb->bytes ? 1 : -1;
+    return ra->series - rb->series;
+}
+
+static int cmp_flat_bytes(const void *a, const void *b) {
+    const mem_row_t *ra = a, *rb = b;
+    const footprint_series_t *sa = &sort_series[ra->series];
+    const footprint_series_t *sb = &sort_series[rb->series];
+    if (sa->bytes != sb->bytes) return sa->bytes < sb->bytes ? 1 : -1;
+    return ra->series - rb->series;
+}
+
+static void rebuild_rows(memory_state_t *ms, const footprint_tracker_t *t) {
+    ms->row_count = 0;
+    ms->module_count = 0;
+
+    free(ms->modules);
+    free(ms->rows);
+    ms->modules = calloc((size_t)(t->count + 1), sizeof(mem_module_t));
+    ms->rows = calloc((size_t)(2 * t->count + 1), sizeof(mem_row_t));
+    if (!ms->modules || !ms->rows) return;
+
+    for (int i = 0; i < t->count; i++) {
+        const footprint_series_t *s = &t->series[i];
+        if (s->peak_bytes == 0) continue;
+
+        const char *name = intern_str(s->name);
+        int len = name ? module_len(name) : 0;
+        int m = 0;
+        while (m < ms->module_count &&
+               !(ms->modules[m].name_len == len &&
+                 (len == 0 || strncmp(ms->modules[m].name, name, (size_t)len) == 0))) {
+            m++;
+        }
+        if (m == ms->module_count) {
+            ms->modules[m].name = name;
+            ms->modules[m].name_len = len;
+            ms->module_count++;
+            if (!ms->flat) ms->rows[ms->row_count++] = (mem_row_t){ m, -1 };
+        }
+        mem_module_t *mod = &ms->modules[m];
+        mod->bytes += s->bytes;
+        mod->first_bytes += s->first_bytes;
+        mod->component_count++;
+        if (footprint_series_growing(s)) mod->growing_count++;
+        ms->rows[ms->row_count++] = (mem_row_t){ ms->flat ? -1 : m, i };
+    }
+
+    sort_series = t->series;
+    sort_modules = ms->modules;
+    qsort(ms->rows, (size_t)ms->row_count, sizeof(mem_row_t),
+          ms->flat ? cmp_flat_bytes : cmp_series_bytes);
+    sort_series = NULL;
+    sort_modules = NULL;
+}
+
+/* --- Lifecycle --- */
+
+void tab_memory_init(tab_t *self) {
+    memory_state_t *ms = calloc(1, sizeof(memory_state_t));
+    if (!ms) return;
+    scroll_reset(&ms->scroll);
+    self->state = ms;
+}
+
+void tab_memory_fini(tab_t *self) {
+    memory_state_t *ms = (memory_state_t *)self->state;
+    if (!ms) return;
+    free(ms->modules);
+    free(ms->rows);
+    free(ms);
+    self->state = NULL;
+}
+
+/* --- Draw --- */
+
+void tab_memory_draw(const tab_t *self, WINDOW *win, const void *app_state) {
+    memory_state_t *ms = (memory_state_t *)self->state;
+    if (!ms) return;
+
+    const app_state_t *state = (const app_state_t *)app_state;
+    const footprint_tracker_t *t = &state->footprints;
+
+    werase(win);
+    int max_y = getmaxy(win);
+    int max_x = getmaxx(win);
+
+    if (t->seq == 0) {
+        const char *msg = "Waiting for component data...";
+        wattron(win, A_DIM);
+        mvwprintw(win, max_y / 2, (max_x - (int)strlen(msg)) / 2, "%s", msg);
+        wattroff(win, A_DIM);
+        wnoutrefresh(win);
+        return;
+    }
+
+    if (!ms->built || ms->seen_seq != t->seq || ms->seen_flat != ms->flat) {
+        rebuild_rows(ms, t);
+        ms->seen_seq = t->seq;
+        ms->seen_flat = ms->flat;
+        ms->built = true;
+    }
+
+    /* Summary: world total, change over the session, total trend */
+    int growing = 0;
+    for (int i = 0; i < t->count; i++) {
+        if (footprint_series_growing(&t->series[i])) growing++;
+    }
+    char total[24], peak[24], delta[24];
+    format_bytes((double)t->total_bytes, total, sizeof(total));
+    format_bytes((double)t->peak_total_bytes, peak, sizeof(peak));
+    format_delta(t->total_bytes, t->first_total_bytes, delta, sizeof(delta));
+
+    wattron(win, COLOR_PAIR(CP_LABEL));
+    mvwprintw(win, 0, 2, "Component data:");
+    wattroff(win, COLOR_PAIR(CP_LABEL));
+    wattron(win, COLOR_PAIR(CP_JSON_NUMBER) | A_BOLD);
+    wprintw(win, " %s", total);
+    wattroff(win, COLOR_PAIR(CP_JSON_NUMBER) | A_BOLD);
+    wprintw(win, "  peak %s  %s over %.0fs (%llu samples)", peak, delta,
+            (double)(t->last_ms - t->first_ms) / 1000.0,
+            (unsigned long long)t->seq);
+    if (growing > 0) {
+        wattron(win, COLOR_PAIR(CP_RECONNECTING) | A_BOLD);
+        wprintw(win, "  %d growing", growing);
+        wattroff(win, COLOR_PAIR(CP_RECONNECTING) | A_BOLD);
+    }
+    if (max_x > SPARK_WIDTH + 2) {
+        draw_footprint_sparkline(win, 0, max_x - SPARK_WIDTH - 2, t, NULL, CP_LABEL);
+    }
+
+    /* Column layout, right to left: trend, change, footprint, count, size */
+    int spark_col = max_x - SPARK_WIDTH - 2;
+    int delta_col = spark_col - 10;
+    int bytes_col = delta_col - 10;
+    int count_col = bytes_col - 9;
+    int size_col = count_col - 8;
+    int name_width = size_col - 5;
+    if (name_width < 8) name_width = 8;
+
+    wattron(win, COLOR_PAIR(CP_LABEL));
+    mvwprintw(win, 2, 2, "%-*s", name_width, ms->flat ? "Component" : "Module / component");
+    mvwprintw(win, 2, size_col, "%7s %8s %9s %9s", "Size", "Entities", "Bytes", "Change");
+    mvwprintw(win, 2, spark_col, "Trend");
+    wattroff(win, COLOR_PAIR(CP_LABEL));
+
+    int list_top = 3;
+    int visible = max_y - list_top;
+    if (visible < 1) visible = 1;
+    ms->scroll.total_items = ms->row_count;
+    ms->scroll.visible_rows = visible;
+    scroll_ensure_visible(&ms->scroll);
+
+    if (ms->row_count == 0) {
+        wattron(win, A_DIM);
+        mvwprintw(win, list_top + 1, 2, "No sized components");
+        wattroff(win, A_DIM);
+    }
+
+    for (int r = 0; r < visible; r++) {
+        int idx = ms->scroll.scroll_offset + r;
+        if (idx >= ms->row_count) break;
+        const mem_row_t *row = &ms->rows[idx];
+        int y = list_top + r;
+        bool is_cursor = (idx == ms->scroll.cursor);
+        char bytes[24], change[24];
+
+        if (is_cursor) wattron(win, A_REVERSE);
+        wmove(win, y, 1);
+        for (int c = 1; c < max_x - 1; c++) waddch(win, ' ');
+
+        if (row->series < 0) {
+            const mem_module_t *mod = &ms->modules[row->module];
+            format_bytes((double)mod->bytes, bytes, sizeof(bytes));
+            format_delta(mod->bytes, mod->first_bytes, change, sizeof(change));
+            wattron(win, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
+            if (mod->name_len > 0) {
+                mvwprintw(win, y, 2, "%.*s", mod->name_len < name_width ? mod->name_len : name_width,
+                          mod->name);
+            } else {
+                mvwprintw(win, y, 2, "(root)");
+            }
+            wattroff(win, COLOR_PAIR(CP_COMPONENT_HEADER) | A_BOLD);
+            wattron(win, A_DIM);
+            wprintw(win, " %d", mod->component_count);
+            wattroff(win, A_DIM);
+            if (mod->growing_count > 0) {
+                wattron(win, COLOR_PAIR(CP_RECONNECTING));
+                wprintw(win, " (%d growing)", mod->growing_count);
+                wattroff(win, COLOR_PAIR(CP_RECONNECTING));
+            }
+            wattron(win, COLOR_PAIR(CP_JSON_NUMBER) | A_BOLD);
+            mvwprintw(win, y, bytes_col, "%9s", bytes);
+            wattroff(win, COLOR_PAIR(CP_JSON_NUMBER) | A_BOLD);
+            mvwprintw(win, y, delta_col, "%9s", change);
+        } else {
+            const footprint_series_t *s = &t->series[row->series];
+            const char *name = intern_str(s->name);
+            if (!name) name = "?";
+            if (!ms->flat) name += module_len(name) > 0 ? module_len(name) + 1 : 0;
+            bool grow = footprint_series_growing(s);
+            int indent = ms->flat ? 2 : 4;
+
+            format_bytes((double)s->bytes, bytes, sizeof(bytes));
+            format_delta(s->bytes, s->first_bytes, change, sizeof(change));
+            if (grow) wattron(win, COLOR_PAIR(CP_RECONNECTING) | A_BOLD);
+            else wattron(win, COLOR_PAIR(CP_ENTITY_NAME));
+            mvwprintw(win, y, indent, "%s%.*s", grow ? "^ " : "",
+                      name_width - indent + 2 - (grow ? 2 : 0), name);
+            if (grow) wattroff(win, COLOR_PAIR(CP_RECONNECTING) | A_BOLD);
+            else wattroff(win, COLOR_PAIR(CP_ENTITY_NAME));
+
+            mvwprintw(win, y, size_col, "%6dB %8d", s->size, s->entity_count);
+            wattron(win, COLOR_PAIR(CP_JSON_NUMBER));
+            mvwprintw(win, y, bytes_col, "%9s", bytes);
+            wattroff(win, COLOR_PAIR(CP_JSON_NUMBER));
+            if (grow) wattron(win, COLOR_PAIR(CP_RECONNECTING));
+            mvwprintw(win, y, delta_col, "%9s", change);
+            if (grow) wattroff(win, COLOR_PAIR(CP_RECONNECTING));
+            draw_footprint_sparkline(win, y, spark_col, t, s, grow ? CP_RECONNECTING : CP_LABEL);
+        }
+
+        if (is_cursor) wattroff(win, A_REVERSE);
+    }
+
+    wnoutrefresh(win);
+}
+
+/* --- Input --- */
+
+bool tab_memory_input(tab_t *self, int ch, void *app_state) {
+    (void)app_state;
+    memory_state_t *ms = (memory_state_t *)self->state;
+    if (!ms) return false;
+
+    switch (ch) {
+    case KEY_UP:
+    case 'k':
+        scroll_move(&ms->scroll, -1);
+        return true;
+
+    case KEY_DOWN:
+    case 'j':
+        scroll_move(&ms->scroll, +1);
+        return true;
+
+    case KEY_PPAGE:
+        scroll_page(&ms->scroll, -1);
+        return true;
+
+    case KEY_NPAGE:
+        scroll_page(&ms->scroll, +1);
+        return true;
+
+    case 'g':
+        scroll_to_top(&ms->scroll);
+        return true;
+
+    case 'G':
+        scroll_to_bottom(&ms->scroll);
+        return true;
+
+    case 'f':
+        ms->flat = !ms->flat;
+        scroll_to_top(&ms->scroll);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,11 @@
+#ifndef CELS_DEBUG_TAB_MEMORY_H
+#define CELS_DEBUG_TAB_MEMORY_H
+
+#include "../tab_system.h"
+
+void tab_memory_init(tab_t *self);
+void tab_memory_fini(tab_t *self);
+void tab_memory_draw(const tab_t *self, WINDOW *win, const void *app_state);
+bool tab_memory_input(tab_t *self, int ch, void *app_state);
+
+#endif /* CELS_DEBUG_TAB_MEMORY_H */
@@ -1,22 +1,223 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "tab_overview.h"
 #include "../tui.h"
+#include "../metric_catalog.h"
+#include "../scroll.h"
+#include "../widgets.h"
 #include <ncurses.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+/* Per-tab private state */
+typedef struct overview_state {
+    bool show_catalog;      /* every world metric instead of the dashboard */
+    scroll_state_t catalog_scroll;
+    int dashboard_offset;   /* first dashboard metric shown */
+    bool show_diagnostics;  /* poller and history tables below the dashboard */
+} overview_state_t;
+
 void tab_overview_init(tab_t *self) {
-    self->state = NULL;
+    self->state = calloc(1, sizeof(overview_state_t));
 }
 
 void tab_overview_fini(tab_t *self) {
-    (void)self;
+    free(self->state);
+    self->state = NULL;
+}
+
+/* --- Metric rows --- */
+
+#define ROW_LABEL_END 24    /* "  * <label, 20>" from column 2 */
+#define ROW_KEY_WIDTH 37    /* " <metric name, 36>" */
+#define ROW_NUM_WIDTH 12    /* " <value, 11>" */
+
+/* Columns of a metric row that fit in width: the label and current value
+ * always, then the metric key (catalog only), the minute's avg/min/max
+ * and last the sparkline. Header and rows share one layout. */
+typedef struct row_layout {
+    bool key;
+    bool stats;
+    bool spark;
+} row_layout_t;
+
+static row_layout_t row_layout(int width, bool with_key) {
+    row_layout_t l = {0};
+    int used = ROW_LABEL_END + ROW_NUM_WIDTH;
+    l.key = with_key && used + ROW_KEY_WIDTH <= width;
+    if (l.key) used += ROW_KEY_WIDTH;
+    l.stats = used + 3 * ROW_NUM_WIDTH <= width;
+    if (l.stats) used += 3 * ROW_NUM_WIDTH;
+    l.spark = l.stats && used + 1 + SPARK_WIDTH <= width;
+    return l;
+}
+
+static void draw_metric_header(WINDOW *win, int row, const char *title,
+                               row_layout_t l) {
+    wattron(win, COLOR_PAIR(CP_LABEL));
+    mvwprintw(win, row, 2, "  %-20s", title);
+    if (l.key) wprintw(win, " %-36s", "Key");
+    wprintw(win, " %11s", "Now");
+    if (l.stats) wprintw(win, " %11s %11s %11s", "1min avg", "Min", "Max");
+    wattroff(win, COLOR_PAIR(CP_LABEL));
+}
+
+/* Latest value, then mean/min/max over the last minute, in display units */
+static void draw_metric_row(WINDOW *win, int row, const metric_history_t *h,
+                            const char *name, bool pinned, row_layout_t l) {
+    metric_info_t info = metric_catalog_describe(name);
+    const metric_series_t *s = metric_history_find(h, name);
+
+    mvwprintw(win, row, 2, "%c %-20.20s", pinned ? '*' : ' ', info.label);
+    if (l.key) {
+        wattron(win, A_DIM);
+        wprintw(win, " %-36.36s", name);
+        wattroff(win, A_DIM);
+    }
+    if (!s) {
+        wattron(win, A_DIM);
+        wprintw(win, " not reported");
+        wattroff(win, A_DIM);
+        return;
+    }
+
+    metric_sample_t last;
+    metric_stats_t st = metric_history_stats(h, s, METRIC_HISTORY_CAPACITY);
+    char now[24], avg[24], lo[24], hi[24];
+    if (metric_history_recent(h, s, &last, 1) == 1 && last.avg == last.avg) {
+        metric_catalog_format(&info, metric_catalog_value(&info, last.avg), now, sizeof(now));
+    } else {
+        snprintf(now, sizeof(now), "-");
+    }
+    metric_catalog_format(&info, metric_catalog_value(&info, st.avg), avg, sizeof(avg));
+    metric_catalog_format(&info, metric_catalog_value(&info, st.min), lo, sizeof(lo));
+    metric_catalog_format(&info, metric_catalog_value(&info, st.max), hi, sizeof(hi));
+
+    wattron(win, COLOR_PAIR(CP_JSON_NUMBER));
+    wprintw(win, " %11s", now);
+    wattroff(win, COLOR_PAIR(CP_JSON_NUMBER));
+    if (st.count > 0 && l.stats) {
+        wprintw(win, " %11s %11s %11s", avg, lo, hi);
+        if (l.spark) draw_history_sparkline(win, row, getcurx(win) + 1, h, s, CP_LABEL);
+    }
+}
+
+/* Every metric the last /stats/world response carried, in response order.
+ * Space pins/unpins the selected one on the dashboard. */
+static void draw_catalog(overview_state_t *os, WINDOW *win, const app_state_t *state) {
+    const metric_history_t *h = &state->world_history;
+    int max_y = getmaxy(win);
+
+    wattron(win, A_BOLD);
+    mvwprintw(win, 0, 2, "World metrics");
+    wattroff(win, A_BOLD);
+    wattron(win, A_DIM);
+    wprintw(win, " (%d reported, %d pinned -- space toggles)", h->series_count,
+            state->dashboard_count);
+    wattroff(win, A_DIM);
+    row_layout_t layout = row_layout(getmaxx(win), true);
+    draw_metric_header(win, 1, "Metric", layout);
+
+    os->catalog_scroll.total_items = h->series_count;
+    os->catalog_scroll.visible_rows = max_y - 2 > 1 ? max_y - 2 : 1;
+    scroll_ensure_visible(&os->catalog_scroll);
+
+    for (int r = 0; r < os->catalog_scroll.visible_rows; r++) {
+        int idx = os->catalog_scroll.scroll_offset + r;
+        if (idx >= h->series_count) break;
+        intern_id_t id = h->series[idx].name;
+        bool pinned = false;
+        for (int d = 0; d < state->dashboard_count; d++) pinned = pinned || state->dashboard[d] == id;
+
+        bool is_cursor = idx == os->catalog_scroll.cursor;
+        if (is_cursor) wattron(win, A_REVERSE);
+        draw_metric_row(win, 2 + r, h, intern_str(id), pinned, layout);
+        if (is_cursor) wattroff(win, A_REVERSE);
+    }
+}
+
+/* Poller work and metric history bookkeeping, from row down */
+static void draw_diagnostics(WINDOW *win, int row, const app_state_t *state) {
+    /* Poller work: responses parsed vs. skipped as unchanged */
+    static const char *slot_names[POLL_SLOT_COUNT] = {
+        [POLL_SLOT_STATS_WORLD]    = "/stats/world",
+        [POLL_SLOT_QUERY]          = "/query",
+        [POLL_SLOT_ENTITY]         = "/entity",
+        [POLL_SLOT_COMPONENTS]     = "/components",
+        [POLL_SLOT_STATS_PIPELINE] = "/stats/pipeline",
+        [POLL_SLOT_WORLD]          = "/world",
+    };
+    wattron(win, COLOR_PAIR(CP_LABEL));
+    mvwprintw(win, row, 2, "%-17s %10s %10s", "Endpoint", "Parsed", "Skipped");
+    wattroff(win, COLOR_PAIR(CP_LABEL));
+    for (int i = 0; i < POLL_SLOT_COUNT; i++) {
+        const poll_endpoint_stats_t *st = &state->poll_stats[i];
+        mvwprintw(win, row + 1 + i, 2, "%-17s %10llu %10llu", slot_names[i],
+                  (unsigned long long)st->parsed,
+                  (unsigned long long)st->skipped);
+    }
+
+    /* Metric history: series tracked and fixed memory per source */
+    const metric_history_t *hists[2] = {
+        &state->world_history, &state->pipeline_history,
+    };
+    static const char *hist_names[2] = { "World", "Pipeline" };
+    wattron(win, COLOR_PAIR(CP_LABEL));
+    mvwprintw(win, row + 2 + POLL_SLOT_COUNT, 2, "%-17s %10s %10s %10s %6s %8s",
+              "History", "Metrics", "Seconds", "Memory", "Gaps", "Dropped");
+    wattroff(win, COLOR_PAIR(CP_LABEL));
+    for (int i = 0; i < 2; i++) {
+        const metric_history_t *h = hists[i];
+        mvwprintw(win, row + 3 + POLL_SLOT_COUNT + i, 2, "%-17s %10d %10.0f %8.1fMB %6llu",
+                  hist_names[i], h->series_count,
+                  (double)h->seq / METRIC_SAMPLE_HZ,
+                  (double)metric_history_bytes(h) / (1024.0 * 1024.0),
+                  (unsigned long long)h->gaps);
+        /* Metrics left without history because the cap was reached */
+        if (h->dropped > 0) wattron(win, COLOR_PAIR(CP_RECONNECTING));
+        wprintw(win, " %8d", h->dropped);
+        if (h->dropped > 0) wattroff(win, COLOR_PAIR(CP_RECONNECTING));
+    }
+}
+
+/* The pinned world metrics ('c' opens the catalog) from row down; j/k
+ * scroll when they do not all fit */
+static void draw_dashboard(overview_state_t *os, WINDOW *win, int row,
+                           const app_state_t *state) {
+    row_layout_t layout = row_layout(getmaxx(win), false);
+    int visible = getmaxy(win) - row - 1;
+    if (visible < 1) return;
+
+    int offset = os ? os->dashboard_offset : 0;
+    if (offset > state->dashboard_count - visible) offset = state->dashboard_count - visible;
+    if (offset < 0) offset = 0;
+    if (os) os->dashboard_offset = offset;
+
+    draw_metric_header(win, row++, "Dashboard", layout);
+    if (state->dashboard_count > visible) {
+        int last = offset + visible < state->dashboard_count
+            ? offset + visible : state->dashboard_count;
+        wattron(win, A_DIM);
+        wprintw(win, "  %d-%d of %d", offset + 1, last, state->dashboard_count);
+        wattroff(win, A_DIM);
+    }
+    for (int d = offset; d < state->dashboard_count && d < offset + visible; d++) {
+        draw_metric_row(win, row++, &state->world_history,
+                        intern_str(state->dashboard[d]), false, layout);
+    }
 }
 
 void tab_overview_draw(const tab_t *self, WINDOW *win,
                        const void *app_state) {
-    (void)self;
+    overview_state_t *os = (overview_state_t *)self->state;
     const app_state_t *state = (const app_state_t *)app_state;
 
-    if (state->snapshot) {
+    werase(win);
+
+    if (os && os->show_catalog) {
+        draw_catalog(os, win, state);
+    } else if (state->snapshot) {
         /* Dashboard: labels in cyan, values in default color */
         wattron(win, COLOR_PAIR(CP_LABEL));
         mvwprintw(win, 1, 2, "Entities:");
@@ -37,6 +238,35 @@ void tab_overview_draw(const tab_t *self, WINDOW *win,
         mvwprintw(win, 4, 2, "Systems:");
         wattroff(win, COLOR_PAIR(CP_LABEL));
         wprintw(win, "    %.0f", state->snapshot->system_count);
+
+        /* Frame-time distribution over the selected window ('w' cycles) */
+        quantile_summary_t q = quantile_tracker_summary(state->frame_quantiles,
+                                                        state->quantile_window);
+        wattron(win, COLOR_PAIR(CP_LABEL));
+        mvwprintw(win, 5, 2, "Frame %-6s", quantile_window_name(state->quantile_window));
+        wattroff(win, COLOR_PAIR(CP_LABEL));
+        if (q.count > 0) {
+            wprintw(win, " p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms",
+                    q.p50, q.p95, q.p99, q.max);
+        } else {
+            wattron(win, A_DIM);
+            wprintw(win, " no samples yet");
+            wattroff(win, A_DIM);
+        }
+        if (state->spikes.fired > 0) {
+            wattron(win, COLOR_PAIR(CP_RECONNECTING));
+            wprintw(win, "  %llu spike%s", (unsigned long long)state->spikes.fired,
+                    state->spikes.fired == 1 ? "" : "s");
+            wattroff(win, COLOR_PAIR(CP_RECONNECTING));
+        }
+
+        /* Below the gauges: the pinned metrics, or with 'd' the poller
+         * and history diagnostics */
+        if (os && os->show_diagnostics) {
+            draw_diagnostics(win, 7, state);
+        } else {
+            draw_dashboard(os, win, 7, state);
+        }
     } else {
         /* No data yet -- center message */
         const char *msg = "Waiting for data...";
@@ -49,9 +279,76 @@ void tab_overview_draw(const tab_t *self, WINDOW *win,
     wnoutrefresh(win);
 }
 
+/* Pin or unpin a metric on the dashboard (order of pinning is kept) */
+static void toggle_pin(app_state_t *state, intern_id_t id) {
+    for (int d = 0; d < state->dashboard_count; d++) {
+        if (state->dashboard[d] != id) continue;
+        memmove(&state->dashboard[d], &state->dashboard[d + 1],
+                (size_t)(state->dashboard_count - d - 1) * sizeof(intern_id_t));
+        state->dashboard_count--;
+        return;
+    }
+    if (state->dashboard_count < METRIC_DASHBOARD_MAX) {
+        state->dashboard[state->dashboard_count++] = id;
+    }
+}
+
 bool tab_overview_input(tab_t *self, int ch, void *app_state) {
-    (void)self;
-    (void)ch;
-    (void)app_state;
+    overview_state_t *os = (overview_state_t *)self->state;
+    app_state_t *state = (app_state_t *)app_state;
+
+    if (ch == 'w') {
+        state->quantile_window = (state->quantile_window + 1) % QUANTILE_WINDOW_COUNT;
+        return true;
+    }
+    if (!os) return false;
+    if (ch == 'c') {
+        os->show_catalog = !os->show_catalog;
+        return true;
+    }
+    if (!os->show_catalog) {
+        /* Dashboard scrolling; the draw clamps the offset */
+        switch (ch) {
+        case 'd':
+            os->show_diagnostics = !os->show_diagnostics;
+            return true;
+        case KEY_UP:
+        case 'k':
+            if (os->dashboard_offset > 0) os->dashboard_offset--;
+            return true;
+        case KEY_DOWN:
+        case 'j':
+            os->dashboard_offset++;
+            return true;
+        }
+        return false;
+    }
+
+    const metric_history_t *h = &state->world_history;
+    switch (ch) {
+    case KEY_UP:
+    case 'k':
+        scroll_move(&os->catalog_scroll, -1);
+        return true;
+    case KEY_DOWN:
+    case 'j':
+        scroll_move(&os->catalog_scroll, +1);
+        return true;
+    case KEY_PPAGE:
+        scroll_page(&os->catalog_scroll, -1);
+        return true;
+    case KEY_NPAGE:
+        scroll_page(&os->catalog_scroll, +1);
+        return true;
+    case ' ':
+    case '\n':
+        if (os->catalog_scroll.cursor < h->series_count) {
+            toggle_pin(state, h->series[os->catalog_scroll.cursor].name);
+        }
+        return true;
+    case 27:  /* Esc */
+        os->show_catalog = false;
+        return true;
+    }
     return false;
 }
@@ -4,10 +4,13 @@
 #include "../tui.h"
 #include "../data_model.h"
 #include "../scroll.h"
+#include "../widgets.h"
 #include <ncurses.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
 
 /* Canonical Flecs pipeline phase execution order.
  * Keep in sync with tree_view.c phase_color_pair(). */
@@ -37,37 +40,37 @@ static int phase_color_pair(const char *phase) {
 /* Per-tab private state */
 typedef struct perf_state {
     scroll_state_t scroll;
+    bool show_spikes;       /* spike log view instead of the waterfall */
+    int spike_cursor;       /* selected spike, 0 = newest */
+    bool by_worst;          /* one list sorted by worst case instead of phases */
 } perf_state_t;
 
-/* --- Tag helpers for self-contained phase detection --- */
-
-static bool has_tag_str(entity_node_t *node, const char *tag_name) {
-    for (int i = 0; i < node->tag_count; i++) {
-        if (node->tags[i] && strstr(node->tags[i], tag_name)) return true;
-    }
-    return false;
-}
-
-static char *extract_phase_from_tags(entity_node_t *node) {
-    for (int i = 0; i < node->tag_count; i++) {
-        if (node->tags[i] && strncmp(node->tags[i], "flecs.pipeline.", 15) == 0) {
-            const char *phase = node->tags[i] + 15;
-            if (phase[0] != '\0') return strdup(phase);
-        }
-    }
-    return NULL;
-}
-
 /* --- Performance entry for waterfall rendering --- */
 
 typedef struct perf_entry {
     const char *name;       /* system name (borrowed from system_registry) */
-    char *phase;            /* phase name (owned, from entity tags) */
-    double time_ms;         /* execution time in ms */
+    const char *phase;      /* phase name (borrowed from system_registry) */
+    double time_ms;         /* execution time in ms (latest sample) */
+    double avg_ms;          /* mean over the last stats window */
+    double worst_ms;        /* slowest frame in the last stats window */
     int color;              /* color pair for this phase */
     bool disabled;          /* system disabled flag */
+    const metric_series_t *history; /* time_spent over time, or NULL */
 } perf_entry_t;
 
+/* --- Per-system history --- */
+
+/* time_spent history of a system. Keyed by full path, so it outlives the
+ * registry that is replaced on every poll. */
+static const metric_series_t *time_series(const metric_history_t *h,
+                                          const char *full_path) {
+    if (!full_path) return NULL;
+    char key[512];
+    int n = snprintf(key, sizeof(key), "%s.time_spent", full_path);
+    if (n < 0 || (size_t)n >= sizeof(key)) return NULL;
+    return metric_history_find(h, key);
+}
+
 /* --- Phase group for sorted rendering --- */
 
 typedef struct phase_group {
@@ -92,6 +95,14 @@ static void phase_group_add(phase_group_t *pg, perf_entry_t entry) {
     pg->total_time += entry.time_ms;
 }
 
+static int cmp_worst_desc(const void *a, const void *b) {
+    const perf_entry_t *ea = *(const perf_entry_t *const *)a;
+    const perf_entry_t *eb = *(const perf_entry_t *const *)b;
+    if (ea->worst_ms < eb->worst_ms) return 1;
+    if (ea->worst_ms > eb->worst_ms) return -1;
+    return 0;
+}
+
 /* --- Lifecycle --- */
 
 void tab_performance_init(tab_t *self) {
@@ -107,6 +118,114 @@ void tab_performance_fini(tab_t *self) {
     self->state = NULL;
 }
 
+/* --- Spike log view --- */
+
+static int cmp_time_desc(const void *a, const void *b) {
+    const system_info_t *sa = *(const system_info_t *const *)a;
+    const system_info_t *sb = *(const system_info_t *const *)b;
+    if (sa->time_spent_ms < sb->time_spent_ms) return 1;
+    if (sa->time_spent_ms > sb->time_spent_ms) return -1;
+    return 0;
+}
+
+/* Captured spikes (newest first) above, the selected spike's frozen
+ * pipeline below, slowest systems first */
+static void draw_spikes(perf_state_t *ps, WINDOW *win, const app_state_t *state) {
+    const spike_log_t *log = &state->spikes;
+    int max_y = getmaxy(win);
+    int max_x = getmaxx(win);
+
+    char trigger[48];
+    spike_trigger_describe(&log->trigger, trigger, sizeof(trigger));
+    wattron(win, A_BOLD);
+    mvwprintw(win, 0, 2, "Frame spikes");
+    wattroff(win, A_BOLD);
+    wattron(win, A_DIM);
+    wprintw(win, " (trigger %s, %llu captured, newest %d kept)", trigger,
+            (unsigned long long)log->fired, log->count);
+    wattroff(win, A_DIM);
+
+    wattron(win, A_DIM);
+    wmove(win, 1, 1);
+    for (int x = 0; x < max_x - 2; x++) waddch(win, ACS_HLINE);
+    wattroff(win, A_DIM);
+
+    if (log->count == 0) {
+        wattron(win, A_DIM);
+        mvwprintw(win, 3, 2, log->trigger.mode == SPIKE_MODE_OFF
+                  ? "Spike trigger is off (start with -s 33ms or -s 3x)"
+                  : "No spikes yet");
+        wattroff(win, A_DIM);
+        return;
+    }
+    if (ps->spike_cursor >= log->count) ps->spike_cursor = log->count - 1;
+
+    /* List: at most a third of the window, scrolled to keep the cursor */
+    int list_rows = max_y / 3;
+    if (list_rows < 3) list_rows = 3;
+    int first = ps->spike_cursor >= list_rows ? ps->spike_cursor - list_rows + 1 : 0;
+    int row = 2;
+    for (int i = first; i < log->count && i < first + list_rows; i++, row++) {
+        const spike_record_t *rec = spike_log_get(log, i);
+        if (i == ps->spike_cursor) wattron(win, A_REVERSE);
+        mvwprintw(win, row, 2, "#%-4llu t+%8.1fs  %8.2fms  (threshold %.2fms, median %.2fms)",
+                  (unsigned long long)rec->id,
+                  (double)rec->seq / METRIC_SAMPLE_HZ, rec->frame_time_ms,
+                  rec->threshold_ms, rec->median_ms);
+        if (i == ps->spike_cursor) wattroff(win, A_REVERSE);
+    }
+    row++;
+
+    const spike_record_t *rec = spike_log_get(log, ps->spike_cursor);
+    if (rec->snapshot) {
+        wattron(win, COLOR_PAIR(CP_LABEL));
+        mvwprintw(win, row, 2, "World:");
+        wattroff(win, COLOR_PAIR(CP_LABEL));
+        wprintw(win, " %.0f entities, %.1f fps, %.0f systems",
+                rec->snapshot->entity_count, rec->snapshot->fps,
+                rec->snapshot->system_count);
+    }
+    row++;
+
+    const system_registry_t *reg = rec->systems;
+    if (!reg || reg->count == 0) {
+        wattron(win, A_DIM);
+        mvwprintw(win, row + 1, 2, "No pipeline stats captured");
+        wattroff(win, A_DIM);
+        return;
+    }
+
+    const system_info_t **sorted = malloc((size_t)reg->count * sizeof(*sorted));
+    if (!sorted) return;
+    for (int i = 0; i < reg->count; i++) sorted[i] = &reg->systems[i];
+    qsort(sorted, (size_t)reg->count, sizeof(*sorted), cmp_time_desc);
+
+    double max_time = sorted[0]->time_spent_ms;
+    int name_width = 24;
+    int bar_start = 4 + name_width;
+    int bar_max = max_x - bar_start - 12;
+    if (bar_max < 4) bar_max = 4;
+    row++;
+    for (int i = 0; i < reg->count && row < max_y; i++, row++) {
+        const system_info_t *si = sorted[i];
+        int cp = si->disabled ? CP_SYSTEM_DISABLED : phase_color_pair(si->phase);
+        wattron(win, COLOR_PAIR(cp));
+        mvwprintw(win, row, 4, "%-*.*s", name_width, name_width, si->name ? si->name : "?");
+        wattroff(win, COLOR_PAIR(cp));
+
+        int bar = max_time > 0.0 ? (int)(si->time_spent_ms / max_time * bar_max) : 0;
+        if (bar < 1 && si->time_spent_ms > 0.0) bar = 1;
+        wattron(win, COLOR_PAIR(cp) | A_BOLD);
+        wmove(win, row, bar_start);
+        for (int b = 0; b < bar; b++) waddch(win, ACS_HLINE);
+        wattroff(win, COLOR_PAIR(cp) | A_BOLD);
+        wattron(win, COLOR_PAIR(CP_JSON_NUMBER));
+        mvwprintw(win, row, bar_start + bar + 1, "%.3fms", si->time_spent_ms);
+        wattroff(win, COLOR_PAIR(CP_JSON_NUMBER));
+    }
+    free(sorted);
+}
+
 /* --- Draw --- */
 
 void tab_performance_draw(const tab_t *self, WINDOW *win,
@@ -121,6 +240,12 @@ void tab_performance_draw(const tab_t *self, WINDOW *win,
     int max_y = getmaxy(win);
     int max_x = getmaxx(win);
 
+    if (ps->show_spikes) {
+        draw_spikes(ps, win, state);
+        wnoutrefresh(win);
+        return;
+    }
+
     /* No data: show waiting message */
     if (!state->system_registry || state->system_registry->count == 0) {
         const char *msg = "Waiting for pipeline data...";
@@ -132,9 +257,8 @@ void tab_performance_draw(const tab_t *self, WINDOW *win,
         return;
     }
 
-    /* Build perf entries: for each system in registry, find phase from entity tags */
+    /* Build perf entries: one per system in registry, grouped by phase */
     system_registry_t *reg = state->system_registry;
-    entity_list_t *elist = state->entity_list;
 
     /* Phase groups: one per PHASE_ORDER entry + 1 custom */
     phase_group_t groups[PHASE_ORDER_COUNT + 1];
@@ -154,27 +278,17 @@ void tab_performance_draw(const tab_t *self, WINDOW *win,
         system_info_t *si = &reg->systems[s];
         if (!si->name) continue;
 
-        /* Find phase from entity tags */
-        char *phase = NULL;
-        if (elist) {
-            for (int e = 0; e < elist->root_count; e++) {
-                entity_node_t *node = elist->roots[e];
-                if (!node->name) continue;
-                if (strcmp(node->name, si->name) != 0) continue;
-
-                /* Check if this is a system entity */
-                if (has_tag_str(node, "flecs.system.System")) {
-                    phase = extract_phase_from_tags(node);
-                }
-                break;
-            }
-        }
+        const char *phase = si->phase;  /* from entity tags, see analysis_update */
 
         perf_entry_t entry;
         entry.name = si->name;
         entry.phase = phase;
         entry.time_ms = si->time_spent_ms;
+        entry.avg_ms = si->time_avg_ms;
+        entry.worst_ms = si->time_worst_ms > si->time_spent_ms
+                       ? si->time_worst_ms : si->time_spent_ms;
         entry.disabled = si->disabled;
+        entry.history = time_series(&state->pipeline_history, si->full_path);
 
         /* Determine which group */
         int group_idx = PHASE_ORDER_COUNT; /* default: Custom */
@@ -190,21 +304,46 @@ void tab_performance_draw(const tab_t *self, WINDOW *win,
 
         phase_group_add(&groups[group_idx], entry);
 
-        if (si->time_spent_ms > max_time) max_time = si->time_spent_ms;
+        if (entry.worst_ms > max_time) max_time = entry.worst_ms;
         total_time += si->time_spent_ms;
         total_systems++;
     }
 
+    /* Worst-case mode: a single group of every system, slowest frame first.
+     * Entries are borrowed from the phase groups. */
+    phase_group_t worst = { .phase_name = "By worst case", .color = CP_LABEL };
+    perf_entry_t **worst_order = NULL;
+    if (ps->by_worst && total_systems > 0) {
+        worst_order = malloc((size_t)total_systems * sizeof(*worst_order));
+        if (worst_order) {
+            int n = 0;
+            for (int g = 0; g <= PHASE_ORDER_COUNT; g++) {
+                for (int i = 0; i < groups[g].count; i++) {
+                    worst_order[n++] = &groups[g].entries[i];
+                }
+            }
+            qsort(worst_order, (size_t)n, sizeof(*worst_order), cmp_worst_desc);
+            worst.count = n;
+            worst.total_time = total_time;
+        }
+    }
+    /* Groups to render: the phases in execution order, or the worst list */
+    phase_group_t *view = worst_order ? &worst : groups;
+    int view_count = worst_order ? 1 : PHASE_ORDER_COUNT + 1;
+
     /* Calculate total virtual rows needed for scroll */
     int total_rows = 0;
-    total_rows += 4; /* title + separator + fps + blank */
+    total_rows += 5; /* title + separator + fps + quantiles + blank */
 
-    for (int g = 0; g <= PHASE_ORDER_COUNT; g++) {
-        if (groups[g].count == 0) continue;
+    for (int g = 0; g < view_count; g++) {
+        if (view[g].count == 0) continue;
         total_rows += 1; /* phase header */
-        total_rows += groups[g].count; /* system rows */
+        total_rows += view[g].count; /* system rows */
         total_rows += 1; /* blank after group */
     }
+    if (reg->segment_count > 0) {
+        total_rows += 1 + reg->segment_count + 1; /* header + segments + blank */
+    }
     total_rows += 2; /* separator + summary */
 
     ps->scroll.total_items = total_rows;
@@ -214,9 +353,11 @@ void tab_performance_draw(const tab_t *self, WINDOW *win,
     /* Layout constants */
     int name_col = 4;       /* system name indent */
     int name_width = 24;    /* max name display width */
-    int time_width = 10;    /* "X.XXXms " */
-    int bar_start = name_col + name_width;
-    int bar_max = max_x - bar_start - time_width - 2;
+    int spark_col = name_col + name_width;
+    int time_width = 23;    /* "X.XXXms 1s max X.XXX " (avg, worst) */
+    int stats_width = 47;   /* "1m avg X.XXX sd X.XXX min X.XXX max X.XXX" */
+    int bar_start = spark_col + SPARK_WIDTH + 1;
+    int bar_max = max_x - bar_start - time_width - stats_width - 2;
     if (bar_max < 4) bar_max = 4;
 
     /* Render rows with scroll offset */
@@ -269,73 +410,118 @@ void tab_performance_draw(const tab_t *self, WINDOW *win,
     }
     vrow++;
 
-    /* Row 3: blank */
+    /* Row 3: frame-time distribution over the selected window ('w' cycles) */
+    if (VROW_VISIBLE(vrow)) {
+        quantile_summary_t q = quantile_tracker_summary(state->frame_quantiles,
+                                                        state->quantile_window);
+        wattron(win, COLOR_PAIR(CP_LABEL));
+        mvwprintw(win, SCREEN_ROW(vrow), 2, "Frame %s:", quantile_window_name(state->quantile_window));
+        wattroff(win, COLOR_PAIR(CP_LABEL));
+        if (q.count > 0) {
+            wprintw(win, " p50 %.2fms  p95 %.2fms  p99 %.2fms  max %.2fms",
+                    q.p50, q.p95, q.p99, q.max);
+        } else {
+            wattron(win, A_DIM);
+            wprintw(win, " no samples yet");
+            wattroff(win, A_DIM);
+        }
+    }
+    vrow++;
+
+    /* Row 4: blank */
     vrow++;
 
     /* Phase groups */
-    for (int g = 0; g <= PHASE_ORDER_COUNT; g++) {
-        if (groups[g].count == 0) continue;
+    for (int g = 0; g < view_count; g++) {
+        if (view[g].count == 0) continue;
 
         /* Phase header row */
         if (VROW_VISIBLE(vrow)) {
             int sr = SCREEN_ROW(vrow);
-            int cp = groups[g].color;
+            int cp = view[g].color;
 
             wattron(win, COLOR_PAIR(cp) | A_BOLD);
-            mvwprintw(win, sr, 2, "%s", groups[g].phase_name);
+            mvwprintw(win, sr, 2, "%s", view[g].phase_name);
             wattroff(win, COLOR_PAIR(cp) | A_BOLD);
 
             wattron(win, A_DIM);
             wprintw(win, " (%d system%s, %.2fms)",
-                    groups[g].count,
-                    groups[g].count == 1 ? "" : "s",
-                    groups[g].total_time);
+                    view[g].count,
+                    view[g].count == 1 ? "" : "s",
+                    view[g].total_time);
             wattroff(win, A_DIM);
         }
         vrow++;
 
         /* System rows with timing bars */
-        for (int i = 0; i < groups[g].count; i++) {
+        for (int i = 0; i < view[g].count; i++) {
             if (VROW_VISIBLE(vrow)) {
                 int sr = SCREEN_ROW(vrow);
-                perf_entry_t *entry = &groups[g].entries[i];
+                perf_entry_t *entry = worst_order ? worst_order[i]
+                                                  : &view[g].entries[i];
+                int cp = entry->disabled ? CP_SYSTEM_DISABLED : entry->color;
 
                 /* System name (indented, phase-colored) */
-                if (entry->disabled) {
-                    wattron(win, COLOR_PAIR(CP_SYSTEM_DISABLED));
-                } else {
-                    wattron(win, COLOR_PAIR(groups[g].color));
-                }
+                wattron(win, COLOR_PAIR(cp));
                 mvwprintw(win, sr, name_col, "%-*.*s",
                           name_width, name_width, entry->name);
-                if (entry->disabled) {
-                    wattroff(win, COLOR_PAIR(CP_SYSTEM_DISABLED));
-                } else {
-                    wattroff(win, COLOR_PAIR(groups[g].color));
-                }
-
-                /* Proportional timing bar */
-                int bar_width = 0;
-                if (max_time > 0.0 && entry->time_ms > 0.0) {
-                    bar_width = (int)((entry->time_ms / max_time) * bar_max);
+                wattroff(win, COLOR_PAIR(cp));
+
+                /* Proportional timing bar: solid up to the window average,
+                 * dim up to the worst frame in the window */
+                int avg_width = 0, bar_width = 0;
+                if (max_time > 0.0 && entry->worst_ms > 0.0) {
+                    avg_width = (int)((entry->avg_ms / max_time) * bar_max);
+                    bar_width = (int)((entry->worst_ms / max_time) * bar_max);
                     if (bar_width < 1) bar_width = 1; /* min 1 char for non-zero */
+                    if (avg_width < 1 && entry->avg_ms > 0.0) avg_width = 1;
+                    if (avg_width > bar_width) avg_width = bar_width;
                 }
 
                 if (bar_width > 0) {
-                    wattron(win, COLOR_PAIR(groups[g].color) | A_BOLD);
                     wmove(win, sr, bar_start);
-                    for (int b = 0; b < bar_width; b++) {
+                    wattron(win, COLOR_PAIR(entry->color) | A_BOLD);
+                    for (int b = 0; b < avg_width; b++) {
+                        waddch(win, ACS_HLINE);
+                    }
+                    wattroff(win, COLOR_PAIR(entry->color) | A_BOLD);
+                    wattron(win, COLOR_PAIR(entry->color) | A_DIM);
+                    for (int b = avg_width; b < bar_width; b++) {
                         waddch(win, ACS_HLINE);
                     }
-                    wattroff(win, COLOR_PAIR(groups[g].color) | A_BOLD);
+                    wattroff(win, COLOR_PAIR(entry->color) | A_DIM);
+                }
+
+                if (entry->history) {
+                    /* Per-second averages, so a steady expensive system
+                     * reads as a tall flat line and a noisy one as a
+                     * jagged one */
+                    draw_history_sparkline(win, sr, spark_col, &state->pipeline_history,
+                                           entry->history, entry->color);
                 }
 
-                /* Time label right of bar */
+                /* Avg/worst of flecs' 1 s window right of the bar, rolling
+                 * stats of the last minute after it -- each labelled with
+                 * its span so the two maxima are not confused */
                 int label_col = bar_start + bar_width + 1;
                 if (label_col < max_x - time_width) {
                     wattron(win, COLOR_PAIR(CP_JSON_NUMBER));
-                    mvwprintw(win, sr, label_col, "%.3fms", entry->time_ms);
+                    mvwprintw(win, sr, label_col, "%.3fms", entry->avg_ms);
                     wattroff(win, COLOR_PAIR(CP_JSON_NUMBER));
+                    wattron(win, A_DIM);
+                    wprintw(win, " 1s max %.3f", entry->worst_ms);
+                    wattroff(win, A_DIM);
+                }
+                metric_stats_t st = metric_history_stats(&state->pipeline_history,
+                                                         entry->history,
+                                                         METRIC_HISTORY_CAPACITY);
+                int stats_col = label_col + time_width;
+                if (st.count > 1 && stats_col + stats_width <= max_x) {
+                    wattron(win, A_DIM);
+                    mvwprintw(win, sr, stats_col, "1m avg %.3f sd %.3f min %.3f max %.3f",
+                              st.avg * 1000.0, st.stddev * 1000.0, st.min * 1000.0,
+                              st.max * 1000.0);
+                    wattroff(win, A_DIM);
                 }
             }
             vrow++;
@@ -345,6 +531,87 @@ void tab_performance_draw(const tab_t *self, WINDOW *win,
         vrow++;
     }
 
+    /* Segment timeline: systems between sync points, then the merge */
+    if (reg->segment_count > 0) {
+        double seg_max = 0.0, sync_total = 0.0, pipeline_total = 0.0;
+        int merges = 0;
+        for (int k = 0; k < reg->segment_count; k++) {
+            const pipeline_segment_t *seg = &reg->segments[k];
+            double t = seg->systems_ms + seg->sync_ms;
+            if (t > seg_max) seg_max = t;
+            sync_total += seg->sync_ms;
+            pipeline_total += t;
+            if (seg->has_sync) merges++;
+        }
+
+        if (VROW_VISIBLE(vrow)) {
+            int sr = SCREEN_ROW(vrow);
+            wattron(win, COLOR_PAIR(CP_LABEL) | A_BOLD);
+            mvwprintw(win, sr, 2, "Segments");
+            wattroff(win, COLOR_PAIR(CP_LABEL) | A_BOLD);
+            wattron(win, A_DIM);
+            wprintw(win, " (%d merge%s, sync %.3fms = %.1f%% of pipeline)",
+                    merges, merges == 1 ? "" : "s", sync_total,
+                    pipeline_total > 0.0 ? sync_total / pipeline_total * 100.0 : 0.0);
+            wattroff(win, A_DIM);
+        }
+        vrow++;
+
+        int desc_width = bar_start - name_col - 1;
+        for (int k = 0; k < reg->segment_count; k++) {
+            if (VROW_VISIBLE(vrow)) {
+                int sr = SCREEN_ROW(vrow);
+                const pipeline_segment_t *seg = &reg->segments[k];
+
+                /* "#n MT 4 sys  First..Last" */
+                const char *first = NULL, *last = NULL;
+                if (seg->system_count > 0) {
+                    first = reg->systems[seg->first_system].name;
+                    last = reg->systems[seg->first_system + seg->system_count - 1].name;
+                }
+                char desc[128];
+                snprintf(desc, sizeof(desc), "#%-2d %s %3d sys  %s%s%s", k,
+                         !seg->has_sync ? "--" : seg->multi_threaded ? "MT" : "ST",
+                         seg->system_count, first ? first : "",
+                         last && last != first ? ".." : "",
+                         last && last != first ? last : "");
+                mvwprintw(win, sr, name_col, "%-*.*s", desc_width, desc_width, desc);
+
+                /* Stacked bar: systems time, then the sync point */
+                int sys_width = 0, sync_width = 0;
+                if (seg_max > 0.0) {
+                    sys_width = (int)(seg->systems_ms / seg_max * bar_max);
+                    sync_width = (int)((seg->systems_ms + seg->sync_ms) / seg_max * bar_max)
+                               - sys_width;
+                    if (sys_width < 1 && seg->systems_ms > 0.0) sys_width = 1;
+                    if (sync_width < 1 && seg->sync_ms > 0.0) sync_width = 1;
+                }
+                wmove(win, sr, bar_start);
+                wattron(win, COLOR_PAIR(CP_LABEL) | A_BOLD);
+                for (int b = 0; b < sys_width; b++) waddch(win, ACS_HLINE);
+                wattroff(win, COLOR_PAIR(CP_LABEL) | A_BOLD);
+                wattron(win, COLOR_PAIR(CP_DISCONNECTED) | A_BOLD);
+                for (int b = 0; b < sync_width; b++) waddch(win, ACS_HLINE);
+                wattroff(win, COLOR_PAIR(CP_DISCONNECTED) | A_BOLD);
+
+                int label_col = bar_start + sys_width + sync_width + 1;
+                if (label_col < max_x - time_width) {
+                    wattron(win, COLOR_PAIR(CP_JSON_NUMBER));
+                    mvwprintw(win, sr, label_col, "%.3fms", seg->systems_ms);
+                    wattroff(win, COLOR_PAIR(CP_JSON_NUMBER));
+                    if (seg->has_sync) {
+                        wattron(win, A_DIM);
+                        wprintw(win, " + sync %.3f (max %.3f), %.0f cmds",
+                                seg->sync_ms, seg->sync_worst_ms, seg->commands_enqueued);
+                        wattroff(win, A_DIM);
+                    }
+                }
+            }
+            vrow++;
+        }
+        vrow++;
+    }
+
     /* Bottom separator */
     if (VROW_VISIBLE(vrow)) {
         wattron(win, A_DIM);
@@ -372,16 +639,24 @@ void tab_performance_draw(const tab_t *self, WINDOW *win,
             wprintw(win, "  (%.0f%% of frame budget)", usage);
             wattroff(win, A_DIM);
         }
+
+        /* Systems past the pipeline history cap get no sparkline or
+         * rolling stats */
+        if (state->pipeline_history.dropped > 0) {
+            wattron(win, COLOR_PAIR(CP_RECONNECTING));
+            wprintw(win, "  %d without history (cap %d)",
+                    state->pipeline_history.dropped,
+                    state->pipeline_history.max_series);
+            wattroff(win, COLOR_PAIR(CP_RECONNECTING));
+        }
     }
 
     #undef VROW_VISIBLE
     #undef SCREEN_ROW
 
-    /* Free owned phase strings in entries */
+    free(worst_order);
+
     for (int g = 0; g <= PHASE_ORDER_COUNT; g++) {
-        for (int i = 0; i < groups[g].count; i++) {
-            free(groups[g].entries[i].phase);
-        }
         free(groups[g].entries);
     }
 
@@ -390,12 +665,78 @@ void tab_performance_draw(const tab_t *self, WINDOW *win,
 
 /* --- Input --- */
 
+static bool spike_view_input(perf_state_t *ps, int ch, app_state_t *state) {
+    int count = state->spikes.count;
+    switch (ch) {
+    case KEY_UP:
+    case 'k':
+        if (ps->spike_cursor > 0) ps->spike_cursor--;
+        return true;
+
+    case KEY_DOWN:
+    case 'j':
+        if (ps->spike_cursor < count - 1) ps->spike_cursor++;
+        return true;
+
+    case 'g':
+        ps->spike_cursor = 0;
+        return true;
+
+    case 'G':
+        ps->spike_cursor = count > 0 ? count - 1 : 0;
+        return true;
+
+    case 27:  /* Esc: back to the waterfall */
+        ps->show_spikes = false;
+        return true;
+
+    case 's': {
+        const spike_record_t *rec = spike_log_get(&state->spikes, ps->spike_cursor);
+        if (!rec) return false;
+        char path[64];
+        snprintf(path, sizeof(path), "cels-spike-%llu.json", (unsigned long long)rec->id);
+        char msg[96];
+        if (spike_log_save(rec, path)) {
+            snprintf(msg, sizeof(msg), "Saved %s", path);
+        } else {
+            snprintf(msg, sizeof(msg), "Could not write %s", path);
+        }
+        free(state->footer_message);
+        state->footer_message = strdup(msg);
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        state->footer_message_expire = ts.tv_sec * 1000 + ts.tv_nsec / 1000000 + 3000;
+        return true;
+    }
+    }
+    return false;
+}
+
 bool tab_performance_input(tab_t *self, int ch, void *app_state) {
     perf_state_t *ps = (perf_state_t *)self->state;
     if (!ps) return false;
-    (void)app_state;
+    app_state_t *state = (app_state_t *)app_state;
+
+    switch (ch) {
+    case 'w':
+        state->quantile_window = (state->quantile_window + 1) % QUANTILE_WINDOW_COUNT;
+        return true;
+
+    case 'p':
+        ps->show_spikes = !ps->show_spikes;
+        return true;
+    }
+
+    if (!ps->show_spikes && ch == 'm') {
+        ps->by_worst = !ps->by_worst;
+        scroll_to_top(&ps->scroll);
+        return true;
+    }
+
+    if (ps->show_spikes) return spike_view_input(ps, ch, state);
 
     switch (ch) {
+
     case KEY_UP:
     case 'k':
         scroll_move(&ps->scroll, -1);
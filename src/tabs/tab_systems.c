@@ -56,67 +56,10 @@ typedef struct systems_state {
     display_entry_t *entries;
     int entry_count;
     int entry_capacity;
-} systems_state_t;
-
-/* --- Classification helpers (copied from tab_cels.c for system detection) --- */
-
-static bool has_tag(entity_node_t *node, const char *tag_name) {
-    for (int i = 0; i < node->tag_count; i++) {
-        if (node->tags[i] && strstr(node->tags[i], tag_name)) return true;
-    }
-    return false;
-}
-
-static char *extract_pipeline_phase(entity_node_t *node) {
-    for (int i = 0; i < node->tag_count; i++) {
-        if (node->tags[i] && strncmp(node->tags[i], "flecs.pipeline.", 15) == 0) {
-            const char *phase = node->tags[i] + 15;
-            if (phase[0] != '\0') return strdup(phase);
-        }
-    }
-    return NULL;
-}
 
-/* Classify system entities: set entity_class and class_detail for systems.
- * Only touches system entities -- leaves others unchanged. */
-static void classify_systems(entity_list_t *list) {
-    if (!list) return;
-    for (int i = 0; i < list->root_count; i++) {
-        entity_node_t *node = list->roots[i];
-        if (has_tag(node, "flecs.system.System")) {
-            node->entity_class = ENTITY_CLASS_SYSTEM;
-            free(node->class_detail);
-            node->class_detail = extract_pipeline_phase(node);
-            if (!node->class_detail) node->class_detail = strdup("System");
-        } else if (has_tag(node, "flecs.core.Observer")) {
-            node->entity_class = ENTITY_CLASS_SYSTEM;
-            free(node->class_detail);
-            node->class_detail = strdup("Observer");
-        }
-    }
-}
-
-/* --- Enrichment: merge pipeline stats into system entity nodes --- */
-
-static void enrich_systems_with_pipeline(entity_list_t *list,
-                                          system_registry_t *reg) {
-    if (!list || !reg || reg->count == 0) return;
-
-    for (int i = 0; i < list->root_count; i++) {
-        entity_node_t *node = list->roots[i];
-        if (node->entity_class != ENTITY_CLASS_SYSTEM) continue;
-        if (!node->name) continue;
-
-        for (int s = 0; s < reg->count; s++) {
-            if (reg->systems[s].name &&
-                strcmp(reg->systems[s].name, node->name) == 0) {
-                node->system_match_count = reg->systems[s].matched_entity_count;
-                node->disabled = reg->systems[s].disabled;
-                break;
-            }
-        }
-    }
-}
+    /* Entity list generation the display list was last built from */
+    uint64_t seen_entity_list_gen;
+} systems_state_t;
 
 /* --- Build flat display list --- */
 
@@ -277,20 +220,6 @@ static void rebuild_display_list(systems_state_t *ss, entity_list_t *list) {
     ss->entry_count = idx;
 }
 
-/* --- Helper: find system_info_t by name in system_registry --- */
-
-static system_info_t *find_system_info(const app_state_t *state,
-                                        const char *name) {
-    if (!state->system_registry || !name) return NULL;
-    for (int i = 0; i < state->system_registry->count; i++) {
-        if (state->system_registry->systems[i].name &&
-            strcmp(state->system_registry->systems[i].name, name) == 0) {
-            return &state->system_registry->systems[i];
-        }
-    }
-    return NULL;
-}
-
 /* --- Helper: find entities with overlapping components (approximation) --- */
 
 static entity_node_t **build_system_matches(const entity_detail_t *sys_detail,
@@ -314,39 +243,48 @@ static entity_node_t **build_system_matches(const entity_detail_t *sys_detail,
     if (comp_count == 0) return NULL;
 
     /* Filter out system-internal components */
-    const char *query_comps[64];
+    intern_id_t query_comps[64];
     int query_count = 0;
     for (int i = 0; i < comp_count; i++) {
         if (!comp_names[i]) continue;
         if (strncmp(comp_names[i], "flecs.", 6) == 0) continue;
         if (strcmp(comp_names[i], "Component") == 0) continue;
-        query_comps[query_count++] = comp_names[i];
+        /* Never interned means no listed entity carries it */
+        intern_id_t id = intern_find(comp_names[i]);
+        if (id != INTERN_NONE) query_comps[query_count++] = id;
     }
     if (query_count == 0) return NULL;
 
-    /* Find entities with at least one overlapping component */
-    entity_node_t **matches = malloc((size_t)elist->count * sizeof(entity_node_t *));
+    /* Entities with at least one overlapping component: merge the
+     * components' id-sorted entity lists, dropping duplicates */
+    entity_node_t *const *lists[64];
+    int lens[64], pos[64];
+    int total = 0;
+    for (int q = 0; q < query_count; q++) {
+        lists[q] = entity_list_with_component(elist, query_comps[q], &lens[q]);
+        pos[q] = 0;
+        total += lens[q];
+    }
+    if (total == 0) return NULL;
+
+    entity_node_t **matches = malloc((size_t)total * sizeof(entity_node_t *));
     if (!matches) return NULL;
     int match_count = 0;
 
-    for (int i = 0; i < elist->count; i++) {
-        entity_node_t *node = elist->nodes[i];
-        if (node->entity_class == ENTITY_CLASS_SYSTEM) continue;
-        if (node->entity_class == ENTITY_CLASS_COMPONENT) continue;
-
-        bool has_match = false;
-        for (int q = 0; q < query_count && !has_match; q++) {
-            for (int c = 0; c < node->component_count; c++) {
-                if (node->component_names[c] &&
-                    strcmp(node->component_names[c], query_comps[q]) == 0) {
-                    has_match = true;
-                    break;
-                }
+    for (;;) {
+        entity_node_t *next = NULL;
+        for (int q = 0; q < query_count; q++) {
+            if (pos[q] < lens[q] && (!next || lists[q][pos[q]]->id < next->id)) {
+                next = lists[q][pos[q]];
             }
         }
-        if (has_match) {
-            matches[match_count++] = node;
+        if (!next) break;
+        for (int q = 0; q < query_count; q++) {
+            while (pos[q] < lens[q] && lists[q][pos[q]]->id == next->id) pos[q]++;
         }
+        if (next->entity_class == ENTITY_CLASS_SYSTEM) continue;
+        if (next->entity_class == ENTITY_CLASS_COMPONENT) continue;
+        matches[match_count++] = next;
     }
 
     *out_count = match_count;
@@ -375,7 +313,7 @@ static void draw_system_detail(WINDOW *rwin, int rh, int rw,
     row++;
 
     /* Metadata */
-    system_info_t *sinfo = find_system_info(state, sel->name);
+    system_info_t *sinfo = system_index_for_entity(&state->system_index, sel);
 
     /* Phase */
     row++;
@@ -617,6 +555,20 @@ static void draw_pipeline_viz(WINDOW *rwin, int rh, int rw,
         }
     }
 
+    /* Timing: sum time_spent_ms per phase in one pass over the systems */
+    double ptimes[32] = {0};
+    const system_registry_t *reg = state->system_registry;
+    for (int s = 0; reg && s < reg->count; s++) {
+        entity_node_t *en = system_index_entity(&state->system_index, s);
+        if (!en || en->entity_class != ENTITY_CLASS_SYSTEM || !en->class_detail) continue;
+        for (int p = 0; p < pcount; p++) {
+            if (strcmp(en->class_detail, phases[p]) == 0) {
+                ptimes[p] += reg->systems[s].time_spent_ms;
+                break;
+            }
+        }
+    }
+
     for (int p = 0; p < pcount; p++) {
         if (row >= rh) break;
 
@@ -636,27 +588,9 @@ static void draw_pipeline_viz(WINDOW *rwin, int rh, int rw,
         wprintw(rwin, " %d system%s", sys_count, sys_count == 1 ? "" : "s");
         total_systems += sys_count;
 
-        /* Timing: sum time_spent_ms for systems in this phase */
-        if (state->system_registry && state->entity_list) {
-            double phase_time = 0.0;
-            for (int s = 0; s < state->system_registry->count; s++) {
-                system_info_t *si = &state->system_registry->systems[s];
-                for (int e = 0; e < state->entity_list->root_count; e++) {
-                    entity_node_t *en = state->entity_list->roots[e];
-                    if (en->entity_class == ENTITY_CLASS_SYSTEM &&
-                        en->name && si->name &&
-                        strcmp(en->name, si->name) == 0 &&
-                        en->class_detail &&
-                        strcmp(en->class_detail, phases[p]) == 0) {
-                        phase_time += si->time_spent_ms;
-                        break;
-                    }
-                }
-            }
-            if (phase_time > 0.0) {
-                wprintw(rwin, "   %.1fms", phase_time);
-                total_time += phase_time;
-            }
+        if (ptimes[p] > 0.0) {
+            wprintw(rwin, "   %.1fms", ptimes[p]);
+            total_time += ptimes[p];
         }
 
         if (is_selected) wattroff(rwin, A_REVERSE);
@@ -789,6 +723,19 @@ static void draw_systems_summary(WINDOW *rwin, int rh, int rw,
     }
 }
 
+/* --- Bring the display list up to date with the current datasets --- */
+
+/* Only rebuilds when the entity list was replaced (classification and
+ * pipeline enrichment are done by analysis_update). Also called before
+ * handling input, since entries[] points into entity_list. */
+static void sync_display_list(systems_state_t *ss, const app_state_t *state) {
+    if (!state->entity_list) return;
+    if (ss->seen_entity_list_gen == state->entity_list_gen) return;
+
+    rebuild_display_list(ss, state->entity_list);
+    ss->seen_entity_list_gen = state->entity_list_gen;
+}
+
 /* --- Lifecycle --- */
 
 void tab_systems_init(tab_t *self) {
@@ -842,14 +789,7 @@ void tab_systems_draw(const tab_t *self, WINDOW *win, const void *app_state) {
 
     /* --- Left panel: system list --- */
     if (state->entity_list) {
-        /* Classify system entities */
-        classify_systems(state->entity_list);
-
-        /* Enrich with pipeline stats (match count, disabled state) */
-        enrich_systems_with_pipeline(state->entity_list, state->system_registry);
-
-        /* Build flat display list */
-        rebuild_display_list(ss, state->entity_list);
+        sync_display_list(ss, state);
 
         /* Update scroll state */
         int lh = getmaxy(ss->panel.left) - 2; /* minus border rows */
@@ -917,7 +857,7 @@ void tab_systems_draw(const tab_t *self, WINDOW *win, const void *app_state) {
                 }
 
                 /* Timing info on the right */
-                system_info_t *sinfo = find_system_info(state, node->name);
+                system_info_t *sinfo = system_index_for_entity(&state->system_index, node);
                 if (sinfo && sinfo->time_spent_ms > 0.0) {
                     char timing[32];
                     snprintf(timing, sizeof(timing), "%.2fms", sinfo->time_spent_ms);
@@ -986,6 +926,7 @@ bool tab_systems_input(tab_t *self, int ch, void *app_state) {
     if (!ss) return false;
 
     app_state_t *state = (app_state_t *)app_state;
+    sync_display_list(ss, state);
 
     /* Focus switching: left/right arrows */
     if (split_panel_handle_focus(&ss->panel, ch)) return true;
@@ -1008,6 +949,7 @@ bool tab_systems_input(tab_t *self, int ch, void *app_state) {
                         strcmp(state->entity_detail->path, cur->entity->full_path) != 0) {
                         entity_detail_free(state->entity_detail);
                         state->entity_detail = NULL;
+                        state->entity_detail_gen++;
                     }
                 }
             }
@@ -1026,6 +968,7 @@ bool tab_systems_input(tab_t *self, int ch, void *app_state) {
                         strcmp(state->entity_detail->path, cur->entity->full_path) != 0) {
                         entity_detail_free(state->entity_detail);
                         state->entity_detail = NULL;
+                        state->entity_detail_gen++;
                     }
                 }
             }
@@ -34,6 +34,7 @@ typedef struct tests_state {
 
     /* Track if data has been loaded */
     bool data_loaded;
+    uint64_t seen_report_gen;  /* test_report_gen the display list was built from */
 } tests_state_t;
 
 /* --- Build flat display list grouped by suite --- */
@@ -133,6 +134,7 @@ static void load_test_report(app_state_t *state) {
     /* Free existing report */
     test_report_free(state->test_report);
     state->test_report = NULL;
+    state->test_report_gen++;
 
     /* Read and parse latest.json */
     size_t len = 0;
@@ -570,7 +572,10 @@ void tab_tests_draw(const tab_t *self, WINDOW *win, const void *app_state) {
 
     /* --- Left panel: test list --- */
     if (report && report->test_count > 0) {
-        rebuild_display_list(ts, report);
+        if (ts->seen_report_gen != state->test_report_gen) {
+            rebuild_display_list(ts, report);
+            ts->seen_report_gen = state->test_report_gen;
+        }
 
         int lh = getmaxy(ts->panel.left) - 2;
         int lw = getmaxx(ts->panel.left) - 2;
@@ -540,10 +540,19 @@ void tree_view_render(tree_view_t *tv, WINDOW *win) {
                     wattroff(win, A_DIM);
                 }
             }
-        } else if (node->class_detail) {
-            /* Non-system class_detail (compositions, lifecycles, etc.) */
+        } else if (node->has_component_info || node->class_detail) {
+            /* Component registry annotation, or non-system class_detail
+             * (compositions, lifecycles, etc.) */
             char info_buf[64];
-            snprintf(info_buf, sizeof(info_buf), "[%s]", node->class_detail);
+            if (node->has_component_info && node->component_size > 0) {
+                snprintf(info_buf, sizeof(info_buf), "[%d entities, %dB]",
+                         node->component_entity_count, node->component_size);
+            } else if (node->has_component_info) {
+                snprintf(info_buf, sizeof(info_buf), "[%d entities]",
+                         node->component_entity_count);
+            } else {
+                snprintf(info_buf, sizeof(info_buf), "[%s]", node->class_detail);
+            }
             int info_len = (int)strlen(info_buf);
             int info_col = max_cols - info_len;
             if (info_col > col + 2) {
@@ -563,7 +572,7 @@ void tree_view_render(tree_view_t *tv, WINDOW *win) {
                 }
                 buf_pos += snprintf(comp_buf + buf_pos,
                                     sizeof(comp_buf) - (size_t)buf_pos,
-                                    "%s", node->component_names[c]);
+                                    "%s", intern_str(node->component_ids[c]));
             }
             if (node->component_count > 3) {
                 snprintf(comp_buf + buf_pos,
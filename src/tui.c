@@ -74,7 +74,7 @@ void tui_init(void) {
     noecho();
     keypad(stdscr, TRUE);
     curs_set(0);
-    timeout(100);  /* getch returns ERR after 100ms */
+    timeout(0);    /* non-blocking getch -- main loop waits in poll() */
 
     /* Color support */
     if (has_colors()) {
@@ -133,7 +133,7 @@ void tui_fini(void) {
     }
 }
 
-void tui_render(const tab_system_t *tabs, const app_state_t *state) {
+void tui_render(tab_system_t *tabs, const app_state_t *state) {
     /* 1. Clear shared windows (NOT win_content -- tabs manage their own) */
     werase(win_header);
     werase(win_tabbar);
@@ -184,30 +184,40 @@ void tui_render(const tab_system_t *tabs, const app_state_t *state) {
         }
     }
 
-    /* 4. Content: dispatch to active tab's draw function */
-    tab_system_draw(tabs, win_content, state);
+    /* 4. Content: dispatch to active tab's draw function (skipped when
+     * only the header/footer changed -- the tab's windows keep their
+     * previous contents on screen) */
+    if (tab_system_needs_draw(tabs)) {
+        tab_system_draw(tabs, win_content, state);
+    }
 
     /* 5. Footer: context-sensitive hints + transient message */
     {
         const char *hints;
         switch (tabs->active) {
         case 0:  /* Overview */
-            hints = "1-5:tabs  q:quit";
+            hints = "1-7:tabs  jk:scroll  w:window  c:catalog  d:diagnostics  q:quit";
             break;
         case 1:  /* CELS */
-            hints = "1-5:tabs  jk:scroll  Enter:expand  f:anon  Esc:back  q:quit";
+            hints = "1-7:tabs  jk:scroll  Enter:expand  f:anon  Esc:back  q:quit";
             break;
         case 2:  /* Systems */
-            hints = "1-5:tabs  jk:scroll  Enter:expand  f:anon  Esc:back  q:quit";
+            hints = "1-7:tabs  jk:scroll  Enter:expand  f:anon  Esc:back  q:quit";
             break;
         case 3:  /* Performance */
-            hints = "1-5:tabs  jk:scroll  q:quit";
+            hints = "1-7:tabs  jk:scroll  w:window  m:worst  p:spikes  s:save  q:quit";
             break;
         case 4:  /* Tests */
-            hints = "1-5:tabs  jk:scroll  r:refresh  q:quit";
+            hints = "1-7:tabs  jk:scroll  r:refresh  q:quit";
+            break;
+        case 5:  /* Archetypes */
+            hints = "1-7:tabs  jk:scroll  o:sort  q:quit";
+            break;
+        case 6:  /* Memory */
+            hints = "1-7:tabs  jk:scroll  f:flat  q:quit";
             break;
         default:
-            hints = "1-5:tabs  q:quit";
+            hints = "1-7:tabs  q:quit";
             break;
         }
         mvwprintw(win_footer, 0, 1, "%s", hints);
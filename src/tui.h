@@ -2,7 +2,14 @@
 #define CELS_DEBUG_TUI_H
 
 #include "data_model.h"
+#include "footprint.h"
 #include "http_client.h"  /* for connection_state_t */
+#include "metric_history.h"
+#include "metric_catalog.h"
+#include "quantile.h"
+#include "spike_log.h"
+#include "system_index.h"
+#include "poller.h"       /* for poll_endpoint_stats_t */
 #include "tab_system.h"
 
 /* Color pair IDs (shared with tab implementations) */
@@ -75,6 +82,34 @@ typedef struct app_state {
     test_report_t         *test_report;     /* parsed tests/output/latest.json */
     char                  *test_json_path;  /* path to latest.json (from -t flag) */
     char                  *baseline_json_path; /* path to baseline.json */
+    /* Dataset generations: bumped whenever the matching pointer above is
+     * replaced. Tabs remember the generations they last derived state from
+     * and skip classification/rebuild work while they are unchanged. */
+    uint64_t               snapshot_gen;
+    uint64_t               entity_list_gen;
+    uint64_t               entity_detail_gen;
+    uint64_t               component_registry_gen;
+    uint64_t               system_registry_gen;
+    uint64_t               test_report_gen;
+    /* Poller fetch/parse counters, indexed by POLL_SLOT_* */
+    poll_endpoint_stats_t  poll_stats[POLL_SLOT_COUNT];
+    /* /stats/world and /stats/pipeline metrics beyond flecs' 60-sample
+     * window, rolled up into fixed-size tiers */
+    metric_history_t       world_history;
+    metric_history_t       pipeline_history;
+    /* Frame-time quantiles fed from every new performance.frame_time
+     * sample; quantile_window is the window Overview/Performance show */
+    quantile_tracker_t    *frame_quantiles;
+    quantile_window_t      quantile_window;
+    /* Frame spikes captured by the trigger, browsable from Performance */
+    spike_log_t            spikes;
+    /* Pipeline systems <-> entity nodes, rebuilt with either dataset */
+    system_index_t         system_index;
+    /* size x entity_count per component, one sample per /components poll */
+    footprint_tracker_t    footprints;
+    /* World metrics pinned to the Overview dashboard (-m, 'c' catalog) */
+    intern_id_t            dashboard[METRIC_DASHBOARD_MAX];
+    int                    dashboard_count;
 } app_state_t;
 
 /* Initialize ncurses, signal handlers, atexit, color pairs, windows. */
@@ -83,8 +118,10 @@ void tui_init(void);
 /* Shutdown ncurses, destroy windows, call endwin. */
 void tui_fini(void);
 
-/* Render one frame: header, tab bar, content (via tab dispatch), footer. */
-void tui_render(const tab_system_t *tabs, const app_state_t *state);
+/* Render one frame: header, tab bar, footer, and the active tab's content
+ * if it is marked dirty (see tab_system_mark_dirty). Call only when
+ * something changed -- the main loop does not redraw on idle wakeups. */
+void tui_render(tab_system_t *tabs, const app_state_t *state);
 
 /* Recalculate window sizes from LINES/COLS. Call on KEY_RESIZE. */
 void tui_resize(void);
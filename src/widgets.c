@@ -0,0 +1,56 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "widgets.h"
+#include <math.h>
+#include <stdio.h>
+
+static const char *SPARK_GLYPHS[8] = {
+    "\xe2\x96\x81", "\xe2\x96\x82", "\xe2\x96\x83", "\xe2\x96\x84",
+    "\xe2\x96\x85", "\xe2\x96\x86", "\xe2\x96\x87", "\xe2\x96\x88",
+};
+
+void format_bytes(double bytes, char *buf, size_t size) {
+    if (bytes < 1024.0) {
+        snprintf(buf, size, "%.0fB", bytes);
+    } else if (bytes < 1024.0 * 1024.0) {
+        snprintf(buf, size, "%.1fK", bytes / 1024.0);
+    } else {
+        snprintf(buf, size, "%.1fM", bytes / (1024.0 * 1024.0));
+    }
+}
+
+void draw_sparkline(WINDOW *win, int row, int col, const double *values, int n,
+                    int color) {
+    if (n > SPARK_WIDTH) {
+        values += n - SPARK_WIDTH;
+        n = SPARK_WIDTH;
+    }
+    double hi = 0.0;
+    for (int i = 0; i < n; i++) {
+        if (values[i] > hi) hi = values[i];   /* false for NaN */
+    }
+
+    wattron(win, COLOR_PAIR(color));
+    wmove(win, row, col + SPARK_WIDTH - n);
+    for (int i = 0; i < n; i++) {
+        if (isnan(values[i])) {
+            waddch(win, ' ');
+            continue;
+        }
+        int level = hi > 0.0 ? (int)(values[i] / hi * 7.0 + 0.5) : 0;
+        if (level < 0) level = 0;
+        if (level > 7) level = 7;
+        waddstr(win, SPARK_GLYPHS[level]);
+    }
+    wattroff(win, COLOR_PAIR(color));
+}
+
+void draw_history_sparkline(WINDOW *win, int row, int col,
+                            const metric_history_t *h, const metric_series_t *s,
+                            int color) {
+    metric_bucket_t b[SPARK_WIDTH];
+    double v[SPARK_WIDTH];
+    int n = metric_history_buckets(h, s, METRIC_TIER_SECOND, b, SPARK_WIDTH);
+    for (int i = 0; i < n; i++) v[i] = b[i].count > 0 ? b[i].avg : NAN;
+    draw_sparkline(win, row, col, v, n, color);
+}
@@ -0,0 +1,27 @@
+#ifndef CELS_DEBUG_WIDGETS_H
+#define CELS_DEBUG_WIDGETS_H
+
+#include "metric_history.h"
+#include <ncurses.h>
+#include <stddef.h>
+
+/* Small formatting and drawing helpers shared by the tabs */
+
+#define SPARK_WIDTH 16      /* columns of a sparkline */
+
+/* Byte count as "512B", "1.5K" or "3.2M" */
+void format_bytes(double bytes, char *buf, size_t size);
+
+/* n (<= SPARK_WIDTH) values right-aligned in SPARK_WIDTH columns at
+ * (row, col), as block glyphs scaled from zero to the largest. A NaN
+ * leaves its column blank. */
+void draw_sparkline(WINDOW *win, int row, int col, const double *values, int n,
+                    int color);
+
+/* Per-second means of the last SPARK_WIDTH seconds of a history series,
+ * seconds without samples blank */
+void draw_history_sparkline(WINDOW *win, int row, int col,
+                            const metric_history_t *h, const metric_series_t *s,
+                            int color);
+
+#endif /* CELS_DEBUG_WIDGETS_H */
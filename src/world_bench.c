@@ -0,0 +1,210 @@
+#define _POSIX_C_SOURCE 200809L
+#include "world_bench.h"
+#include "http_client.h"
+#include "json_parser.h"
+#include "poller.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct bench_strategy {
+    const char *name;
+    int         requests;     /* per round */
+    double     *total_ms;     /* one entry per timed round */
+    double      fetch_ms;     /* sums over timed rounds */
+    double      parse_ms;
+    uint64_t    bytes;
+    int         rounds;
+    int         entities;     /* datasets of the last round */
+    int         components;
+} bench_strategy_t;
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Fetch slots as one concurrent batch, unconditionally. Returns false
+ * unless every slot answered 200; adds the body sizes to *bytes. */
+static bool fetch(http_multi_t *m, const int *slots, const char *const *urls,
+                  int n, uint64_t *bytes) {
+    for (int i = 0; i < n; i++) {
+        http_multi_forget(m, slots[i]);
+        http_multi_add(m, slots[i], urls[i]);
+    }
+    http_multi_perform(m);
+    for (int i = 0; i < n; i++) {
+        http_response_t *resp = http_multi_response(m, slots[i]);
+        if (resp->status != 200 || !resp->body.data) return false;
+        *bytes += resp->body.size;
+    }
+    return true;
+}
+
+static void record(bench_strategy_t *s, bool timed, double t0, double t1, double t2,
+                   uint64_t bytes, const entity_list_t *list,
+                   const component_registry_t *reg) {
+    s->entities = list->count;
+    s->components = reg->count;
+    if (!timed) return;
+    s->total_ms[s->rounds++] = t2 - t0;
+    s->fetch_ms += t1 - t0;
+    s->parse_ms += t2 - t1;
+    s->bytes += bytes;
+}
+
+static bool round_per_endpoint(http_multi_t *m, json_reader_t *readers,
+                               const char *path, bench_strategy_t *s, bool timed) {
+    char entity_url[512];
+    const int slots[3] = { POLL_SLOT_QUERY, POLL_SLOT_COMPONENTS, POLL_SLOT_ENTITY };
+    const char *urls[3];
+    for (int i = 0; i < 3; i++) {
+        urls[i] = poll_slot_url(slots[i], path, entity_url, sizeof(entity_url));
+    }
+    int n = path ? 3 : 2;
+    s->requests = n;
+
+    uint64_t bytes = 0;
+    double t0 = now_ms();
+    if (!fetch(m, slots, urls, n, &bytes)) return false;
+    double t1 = now_ms();
+
+    http_response_t *q = http_multi_response(m, POLL_SLOT_QUERY);
+    http_response_t *c = http_multi_response(m, POLL_SLOT_COMPONENTS);
+    http_response_t *e = http_multi_response(m, POLL_SLOT_ENTITY);
+    entity_list_t *list = json_parse_entity_list(&readers[POLL_SLOT_QUERY],
+                                                 q->body.data, q->body.size);
+    component_registry_t *reg =
+        json_parse_component_registry(&readers[POLL_SLOT_COMPONENTS],
+                                      c->body.data, c->body.size);
+    entity_detail_t *detail = path ? json_parse_entity_detail(e->body.data, e->body.size)
+                                   : NULL;
+    double t2 = now_ms();
+
+    bool ok = list && reg && (!path || detail);
+    if (ok) record(s, timed, t0, t1, t2, bytes, list, reg);
+    entity_list_free(list);
+    component_registry_free(reg);
+    entity_detail_free(detail);
+    return ok;
+}
+
+static bool round_bulk(http_multi_t *m, json_reader_t *readers, const char *path,
+                       bench_strategy_t *s, bool timed) {
+    const int slot = POLL_SLOT_WORLD;
+    const char *url = poll_slot_url(slot, NULL, NULL, 0);
+    s->requests = 1;
+
+    uint64_t bytes = 0;
+    double t0 = now_ms();
+    if (!fetch(m, &slot, &url, 1, &bytes)) return false;
+    double t1 = now_ms();
+
+    http_response_t *w = http_multi_response(m, slot);
+    component_registry_t *reg = NULL;
+    entity_detail_t *detail = NULL;
+    entity_list_t *list = json_parse_world(&readers[slot], w->body.data, w->body.size,
+                                           path, &reg, &detail);
+    double t2 = now_ms();
+
+    bool ok = list && reg && (!path || detail);
+    if (ok) record(s, timed, t0, t1, t2, bytes, list, reg);
+    entity_list_free(list);
+    component_registry_free(reg);
+    entity_detail_free(detail);
+    return ok;
+}
+
+/* A named entity with components, like the ones the inspector shows */
+static char *pick_entity(http_multi_t *m, json_reader_t *readers) {
+    const int slot = POLL_SLOT_QUERY;
+    const char *url = poll_slot_url(slot, NULL, NULL, 0);
+    uint64_t bytes = 0;
+    if (!fetch(m, &slot, &url, 1, &bytes)) return NULL;
+
+    http_response_t *q = http_multi_response(m, slot);
+    entity_list_t *list = json_parse_entity_list(&readers[slot], q->body.data, q->body.size);
+    if (!list) return NULL;
+    char *path = NULL;
+    for (int i = 0; i < list->count && !path; i++) {
+        const entity_node_t *node = list->nodes[i];
+        if (!node->is_anonymous && node->component_count > 0 && node->full_path) {
+            path = strdup(node->full_path);
+        }
+    }
+    entity_list_free(list);
+    return path;
+}
+
+static void print_strategy(FILE *out, const bench_strategy_t *s) {
+    qsort(s->total_ms, (size_t)s->rounds, sizeof(double), cmp_double);
+    double n = (double)s->rounds;
+    fprintf(out, "%-14s %8d %10.1f %9.2f %9.2f %9.2f %8.2f %8.2f\n",
+            s->name, s->requests, (double)s->bytes / n / 1024.0,
+            s->fetch_ms / n, s->parse_ms / n, (s->fetch_ms + s->parse_ms) / n,
+            s->total_ms[s->rounds / 2], s->total_ms[s->rounds - 1]);
+}
+
+bool world_bench_run(int rounds, FILE *out) {
+    http_multi_t *m = http_multi_init(POLL_SLOT_COUNT);
+    if (!m) return false;
+    json_reader_t readers[POLL_SLOT_COUNT];
+    memset(readers, 0, sizeof(readers));
+
+    bench_strategy_t per = { .name = "per-endpoint" };
+    bench_strategy_t bulk = { .name = "bulk /world" };
+    per.total_ms = calloc((size_t)rounds, sizeof(double));
+    bulk.total_ms = calloc((size_t)rounds, sizeof(double));
+    char *path = NULL;
+    bool ok = per.total_ms && bulk.total_ms;
+
+    /* Untimed first round: connects, sizes buffers and parser pools */
+    if (ok) {
+        path = pick_entity(m, readers);
+        ok = round_per_endpoint(m, readers, path, &per, false);
+        if (!ok) fprintf(out, "Per-endpoint fetch failed -- is the app running?\n");
+    }
+    if (ok) {
+        ok = round_bulk(m, readers, path, &bulk, false);
+        if (!ok) fprintf(out, "/world fetch failed -- does the app serve it?\n");
+    }
+
+    for (int i = 0; ok && i < rounds; i++) {
+        ok = round_per_endpoint(m, readers, path, &per, true) &&
+             round_bulk(m, readers, path, &bulk, true);
+        if (!ok) fprintf(out, "Round %d failed\n", i + 1);
+    }
+
+    if (ok) {
+        fprintf(out, "%d rounds, detail for %s\n", rounds, path ? path : "(none)");
+        fprintf(out, "Datasets: %d/%d entities, %d/%d components (per-endpoint/bulk)\n\n",
+                per.entities, bulk.entities, per.components, bulk.components);
+        fprintf(out, "%-14s %8s %10s %9s %9s %9s %8s %8s\n", "Strategy", "Requests",
+                "KB/round", "Fetch ms", "Parse ms", "Total ms", "p50", "Max");
+        print_strategy(out, &per);
+        print_strategy(out, &bulk);
+
+        double per_ms = per.fetch_ms + per.parse_ms;
+        double bulk_ms = bulk.fetch_ms + bulk.parse_ms;
+        if (bulk_ms < per_ms) {
+            fprintf(out, "\nBulk is %.2fx faster per cycle here: poll with -w\n",
+                    bulk_ms > 0 ? per_ms / bulk_ms : 0.0);
+        } else {
+            fprintf(out, "\nPer-endpoint is %.2fx faster per cycle here: keep the default\n",
+                    per_ms > 0 ? bulk_ms / per_ms : 0.0);
+        }
+    }
+
+    free(path);
+    free(per.total_ms);
+    free(bulk.total_ms);
+    for (int i = 0; i < POLL_SLOT_COUNT; i++) json_reader_fini(&readers[i]);
+    http_multi_fini(m);
+    return ok;
+}
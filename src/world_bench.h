@@ -0,0 +1,27 @@
+#ifndef CELS_DEBUG_WORLD_BENCH_H
+#define CELS_DEBUG_WORLD_BENCH_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/* Per-endpoint vs bulk /world fetch benchmark (cels-debug -B <rounds>).
+ *
+ * Runs against the live app, without the TUI. Every round fetches what
+ * the CELS tab needs -- entity list, component registry and one entity
+ * detail -- both ways:
+ *   per-endpoint  /query, /components and /entity/<path> in one
+ *                 concurrent batch, each through its own parser
+ *   bulk          one /world request through json_parse_world()
+ * Rounds alternate between the two so drift in the app hits both alike.
+ * ETags are dropped before every request: each one transfers and parses
+ * a full body, as in a cycle where the world changed.
+ *
+ * Per-request overhead in the app (routing, query setup, serialization)
+ * shows up in the fetch time, payload size in the bytes and parse time.
+ * Bulk mode (-w) pays off when the per-endpoint total is higher. */
+
+/* Run the benchmark and print the comparison to out. Returns false if the
+ * app could not be reached or answered with something unparseable. */
+bool world_bench_run(int rounds, FILE *out);
+
+#endif /* CELS_DEBUG_WORLD_BENCH_H */